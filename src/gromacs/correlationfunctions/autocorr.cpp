@@ -51,6 +51,8 @@
 #include <cstring>
 
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 #include "gromacs/correlationfunctions/expfit.h"
 #include "gromacs/correlationfunctions/integrate.h"
@@ -83,50 +85,6 @@ static gmx_bool bACFinit = FALSE;
 /*! \brief Data structure for storing command line variables. */
 static t_acf acf;
 
-enum
-{
-    enNorm,
-    enCos,
-    enSin
-};
-
-/*! \brief Routine to compute ACF using FFT. */
-static void low_do_four_core(int nframes, real c1[], real cfour[], int nCos)
-{
-    int                            i = 0;
-    std::vector<std::vector<real>> data;
-    data.resize(1);
-    data[0].resize(nframes, 0);
-    switch (nCos)
-    {
-        case enNorm:
-            for (i = 0; (i < nframes); i++)
-            {
-                data[0][i] = c1[i];
-            }
-            break;
-        case enCos:
-            for (i = 0; (i < nframes); i++)
-            {
-                data[0][i] = cos(c1[i]);
-            }
-            break;
-        case enSin:
-            for (i = 0; (i < nframes); i++)
-            {
-                data[0][i] = sin(c1[i]);
-            }
-            break;
-        default: gmx_fatal(FARGS, "nCos = %d, %s %d", nCos, __FILE__, __LINE__);
-    }
-
-    many_auto_correl(&data);
-    for (i = 0; (i < nframes); i++)
-    {
-        cfour[i] = data[0][i];
-    }
-}
-
 /*! \brief Routine to comput ACF without FFT. */
 static void do_ac_core(int nframes, int nout, real corr[], real c1[], int nrestart, unsigned long mode)
 {
@@ -336,48 +294,70 @@ static void dump_tmp(char* s, int n, real c[])
     gmx_ffclose(fp);
 }
 
-/*! \brief High level ACF routine. */
-static void do_four_core(unsigned long mode, int nframes, real c1[], real csum[], real ctmp[])
+/*! \brief High level ACF routine.
+ *
+ * The series of all components that are needed for the ACF of c1
+ * are transformed together by \p correlation.
+ */
+static void do_four_core(gmx::ManyAutoCorrelation* correlation,
+                         unsigned long             mode,
+                         int                       nframes,
+                         real                      c1[],
+                         real                      csum[])
 {
-    real* cfour;
-    char  buf[32];
-    real  fac;
-    int   j, m, m1;
+    char buf[32];
+    real fac;
+    int  j, m, m1;
 
-    snew(cfour, nframes);
+    /* The number of series that are correlated for each mode */
+    int numSeries;
+    if (MODE(eacNormal))
+    {
+        numSeries = 1;
+    }
+    else if (MODE(eacCos))
+    {
+        numSeries = 2;
+    }
+    else if (MODE(eacP2))
+    {
+        numSeries = 2 * DIM;
+    }
+    else if (MODE(eacP1) || MODE(eacVector))
+    {
+        numSeries = DIM;
+    }
+    else
+    {
+        gmx_fatal(FARGS, "\nUnknown mode in do_autocorr (%lu)", mode);
+    }
+    std::vector<real> cfour(numSeries * nframes);
+    auto              series = [&cfour, nframes](int s) { return cfour.data() + s * nframes; };
 
     if (MODE(eacNormal))
     {
         /********************************************
          *  N O R M A L
          ********************************************/
-        low_do_four_core(nframes, c1, csum, enNorm);
+        std::copy(c1, c1 + nframes, series(0));
+        correlation->compute(cfour);
+        std::copy(series(0), series(0) + nframes, csum);
     }
     else if (MODE(eacCos))
     {
         /***************************************************
          * C O S I N E
          ***************************************************/
-        /* Copy the data to temp array. Since we need it twice
-         * we can't overwrite original.
-         */
+        /* Cosine and sine terms of AC function */
         for (j = 0; (j < nframes); j++)
         {
-            ctmp[j] = c1[j];
+            series(0)[j] = cos(c1[j]);
+            series(1)[j] = sin(c1[j]);
         }
-
-        /* Cosine term of AC function */
-        low_do_four_core(nframes, ctmp, cfour, enCos);
-        for (j = 0; (j < nframes); j++)
-        {
-            c1[j] = cfour[j];
-        }
-
-        /* Sine term of AC function */
-        low_do_four_core(nframes, ctmp, cfour, enSin);
+        correlation->compute(cfour);
         for (j = 0; (j < nframes); j++)
         {
-            c1[j] += cfour[j];
+            c1[j]   = series(0)[j] + series(1)[j];
             csum[j] = c1[j];
         }
     }
@@ -427,62 +407,56 @@ static void do_four_core(unsigned long mode, int nframes, real c1[], real csum[]
             csum[j] = -0.5 * (nframes - j);
         }
 
-        /***** DIAGONAL ELEMENTS ************/
+        /* Copy the diagonal and off-diagonal vector data in linear arrays */
         for (m = 0; (m < DIM); m++)
         {
-            /* Copy the vector data in a linear array */
+            m1 = (m + 1) % DIM;
             for (j = 0; (j < nframes); j++)
             {
-                ctmp[j] = gmx::square(c1[DIM * j + m]);
+                series(m)[j]       = gmx::square(c1[DIM * j + m]);
+                series(DIM + m)[j] = c1[DIM * j + m] * c1[DIM * j + m1];
             }
             if (debug)
             {
                 sprintf(buf, "c1diag%d.xvg", m);
-                dump_tmp(buf, nframes, ctmp);
+                dump_tmp(buf, nframes, series(m));
+                sprintf(buf, "c1off%d.xvg", m);
+                dump_tmp(buf, nframes, series(DIM + m));
             }
+        }
 
-            low_do_four_core(nframes, ctmp, cfour, enNorm);
+        correlation->compute(cfour);
 
+        /***** DIAGONAL ELEMENTS ************/
+        fac = 1.5;
+        for (m = 0; (m < DIM); m++)
+        {
             if (debug)
             {
                 sprintf(buf, "c1dfout%d.xvg", m);
-                dump_tmp(buf, nframes, cfour);
+                dump_tmp(buf, nframes, series(m));
             }
-            fac = 1.5;
             for (j = 0; (j < nframes); j++)
             {
-                csum[j] += fac * (cfour[j]);
+                csum[j] += fac * series(m)[j];
             }
         }
         /******* OFF-DIAGONAL ELEMENTS **********/
+        fac = 3.0;
         for (m = 0; (m < DIM); m++)
         {
-            /* Copy the vector data in a linear array */
-            m1 = (m + 1) % DIM;
-            for (j = 0; (j < nframes); j++)
-            {
-                ctmp[j] = c1[DIM * j + m] * c1[DIM * j + m1];
-            }
-
-            if (debug)
-            {
-                sprintf(buf, "c1off%d.xvg", m);
-                dump_tmp(buf, nframes, ctmp);
-            }
-            low_do_four_core(nframes, ctmp, cfour, enNorm);
             if (debug)
             {
                 sprintf(buf, "c1ofout%d.xvg", m);
-                dump_tmp(buf, nframes, cfour);
+                dump_tmp(buf, nframes, series(DIM + m));
             }
-            fac = 3.0;
             for (j = 0; (j < nframes); j++)
             {
-                csum[j] += fac * cfour[j];
+                csum[j] += fac * series(DIM + m)[j];
             }
         }
     }
-    else if (MODE(eacP1) || MODE(eacVector))
+    else
     {
         /***************************************************
          * V E C T O R & P1
@@ -497,30 +471,28 @@ static void do_four_core(unsigned long mode, int nframes, real c1[], real csum[]
          * First for XX, then for YY, then for ZZ
          * After that we sum them and normalise
          */
-        for (j = 0; (j < nframes); j++)
-        {
-            csum[j] = 0.0;
-        }
         for (m = 0; (m < DIM); m++)
         {
             /* Copy the vector data in a linear array */
             for (j = 0; (j < nframes); j++)
             {
-                ctmp[j] = c1[DIM * j + m];
+                series(m)[j] = c1[DIM * j + m];
             }
-            low_do_four_core(nframes, ctmp, cfour, enNorm);
+        }
+        correlation->compute(cfour);
+        for (j = 0; (j < nframes); j++)
+        {
+            csum[j] = 0.0;
+        }
+        for (m = 0; (m < DIM); m++)
+        {
             for (j = 0; (j < nframes); j++)
             {
-                csum[j] += cfour[j];
+                csum[j] += series(m)[j];
             }
         }
     }
-    else
-    {
-        gmx_fatal(FARGS, "\nUnknown mode in do_autocorr (%lu)", mode);
-    }
 
-    sfree(cfour);
     for (j = 0; (j < nframes); j++)
     {
         c1[j] = csum[j] / static_cast<real>(nframes - j);
@@ -592,6 +564,13 @@ void low_do_autocorr(const char*             fn,
     snew(csum, nframes);
     snew(ctmp, nframes);
 
+    /* Set up the FFT correlation once for all items */
+    std::unique_ptr<gmx::ManyAutoCorrelation> correlation;
+    if (bFour)
+    {
+        correlation = std::make_unique<gmx::ManyAutoCorrelation>(nframes, 1);
+    }
+
     /* Loop over items (e.g. molecules or dihedrals)
      * In this loop the actual correlation functions are computed, but without
      * normalizing them.
@@ -606,7 +585,7 @@ void low_do_autocorr(const char*             fn,
 
         if (bFour)
         {
-            do_four_core(mode, nframes, c1[i], csum, ctmp);
+            do_four_core(correlation.get(), mode, nframes, c1[i], csum);
         }
         else
         {
@@ -44,10 +44,198 @@
 #include "manyautocorrelation.h"
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/fft/fft.h"
 #include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/gmxomp.h"
+#include "gromacs/utility/stringutil.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! The maximum size in bytes of the work buffers of a batch of series
+constexpr size_t c_maxBatchBufferSize = 256 * 1024;
+//! The maximum number of series in a batch
+constexpr int c_maxBatchSize = 64;
+
+//! FFT plans and work buffers for one thread
+struct ThreadWork
+{
+    //! Transform for a full batch of series
+    gmx_fft_t batchFft = nullptr;
+    //! Transform for a single series
+    gmx_fft_t singleFft = nullptr;
+    //! Input and output buffers, with space for a batch of series
+    std::vector<real> in, out;
+};
+
+} // namespace
+
+class ManyAutoCorrelation::Impl
+{
+public:
+    Impl(int numPoints, int numThreads);
+    ~Impl();
+
+    //! Computes the correlation of \p numSeries series in place using the work of \p thread
+    void computeSeries(real* series, int numSeries, int thread);
+
+    //! The number of values in each series
+    int numPoints_;
+    //! The length of the FFT, which includes zero padding
+    int fftSize_;
+    //! The distance between series in the FFT buffers, in reals
+    int fftStride_;
+    //! The number of series in a batch
+    int batchSize_;
+    //! The plans and buffers of each thread
+    std::vector<ThreadWork> threadWork_;
+};
+
+ManyAutoCorrelation::Impl::Impl(int numPoints, int numThreads) :
+    numPoints_(numPoints),
+    // Add buffer size to the arrays.
+    fftSize_((3 * numPoints / 2) + 1),
+    fftStride_(2 * (fftSize_ / 2 + 1)),
+    threadWork_(std::max(numThreads, 1))
+{
+    const int maxBatchSizeForBuffer = c_maxBatchBufferSize / (2 * fftStride_ * sizeof(real));
+    batchSize_                      = std::max(1, std::min(c_maxBatchSize, maxBatchSizeForBuffer));
+
+    for (ThreadWork& work : threadWork_)
+    {
+        gmx_fft_init_many_1d_real(&work.batchFft, fftSize_, batchSize_, GMX_FFT_FLAG_CONSERVATIVE);
+        gmx_fft_init_1d_real(&work.singleFft, fftSize_, GMX_FFT_FLAG_CONSERVATIVE);
+        work.in.resize(batchSize_ * fftStride_);
+        work.out.resize(batchSize_ * fftStride_);
+    }
+}
+
+ManyAutoCorrelation::Impl::~Impl()
+{
+    for (ThreadWork& work : threadWork_)
+    {
+        gmx_many_fft_destroy(work.batchFft);
+        gmx_fft_destroy(work.singleFft);
+    }
+}
+
+void ManyAutoCorrelation::Impl::computeSeries(real* series, int numSeries, int thread)
+{
+    GMX_ASSERT(numSeries <= batchSize_, "Can not compute more series than the batch size");
+
+    ThreadWork& work = threadWork_[thread];
+    real*       in   = work.in.data();
+    real*       out  = work.out.data();
+
+    /* Copy the series to the buffer and pad with zeros */
+    for (int s = 0; s < numSeries; s++)
+    {
+        const real* seriesData = series + s * numPoints_;
+        real*       inSeries   = in + s * fftStride_;
+        std::copy(seriesData, seriesData + numPoints_, inSeries);
+        std::fill(inSeries + numPoints_, inSeries + fftStride_, 0);
+    }
+
+    auto transform = [&](gmx_fft_direction direction, real* inData, real* outData) {
+        if (numSeries == batchSize_)
+        {
+            gmx_fft_many_1d_real(work.batchFft, direction, inData, outData);
+        }
+        else
+        {
+            for (int s = 0; s < numSeries; s++)
+            {
+                gmx_fft_1d_real(work.singleFft, direction, inData + s * fftStride_,
+                                outData + s * fftStride_);
+            }
+        }
+    };
+
+    transform(GMX_FFT_REAL_TO_COMPLEX, in, out);
+
+    /* Compute the power spectrum, the imaginary parts are zero */
+    const real invFftSize = 1.0 / fftSize_;
+    for (int s = 0; s < numSeries; s++)
+    {
+        real* outSeries = out + s * fftStride_;
+        for (int k = 0; k < fftStride_; k += 2)
+        {
+            const real re    = outSeries[k];
+            const real im    = outSeries[k + 1];
+            outSeries[k]     = (re * re + im * im) * invFftSize;
+            outSeries[k + 1] = 0;
+        }
+    }
+
+    transform(GMX_FFT_COMPLEX_TO_REAL, out, in);
+
+    for (int s = 0; s < numSeries; s++)
+    {
+        const real* inSeries = in + s * fftStride_;
+        std::copy(inSeries, inSeries + numPoints_, series + s * numPoints_);
+    }
+}
+
+ManyAutoCorrelation::ManyAutoCorrelation(int numPoints, int numThreads) : impl_(nullptr)
+{
+    if (numPoints < 1)
+    {
+        GMX_THROW(InconsistentInputError("Empty vector supplied"));
+    }
+    impl_.reset(new Impl(numPoints, numThreads));
+}
+
+ManyAutoCorrelation::~ManyAutoCorrelation() = default;
+
+int ManyAutoCorrelation::numPoints() const
+{
+    return impl_->numPoints_;
+}
+
+void ManyAutoCorrelation::compute(ArrayRef<real> series)
+{
+    const int numPoints = impl_->numPoints_;
+    if (series.size() % numPoints != 0)
+    {
+        GMX_THROW(InconsistentInputError(formatString(
+                "The number of values (%zu) is not a multiple of the series length (%d)",
+                series.size(), numPoints)));
+    }
+
+    const int numSeries = series.size() / numPoints;
+    if (numSeries == 0)
+    {
+        return;
+    }
+
+    const int batchSize  = impl_->batchSize_;
+    const int numBatches = (numSeries + batchSize - 1) / batchSize;
+    const int numThreads = std::min(static_cast<int>(impl_->threadWork_.size()), numBatches);
+
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+    for (int thread = 0; thread < numThreads; thread++)
+    {
+        try
+        {
+            for (int batch = thread; batch < numBatches; batch += numThreads)
+            {
+                const int seriesBegin = batch * batchSize;
+                const int seriesEnd   = std::min(seriesBegin + batchSize, numSeries);
+                impl_->computeSeries(series.data() + seriesBegin * numPoints,
+                                     seriesEnd - seriesBegin, thread);
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
+}
+
+} // namespace gmx
 
 int many_auto_correl(std::vector<std::vector<real>>* c)
 {
@@ -73,57 +261,19 @@ int many_auto_correl(std::vector<std::vector<real>>* c)
         }
     }
 #endif
-    // Add buffer size to the arrays.
-    size_t nfft = (3 * ndata / 2) + 1;
-    // Pad arrays with zeros
-    for (auto& i : *c)
+    /* Store the series consecutively */
+    std::vector<real> series(nfunc * ndata);
+    for (size_t i = 0; i < nfunc; i++)
     {
-        i.resize(nfft, 0);
+        std::copy((*c)[i].begin(), (*c)[i].end(), series.begin() + i * ndata);
     }
-#pragma omp parallel
-    {
-        try
-        {
-            gmx_fft_t         fft1;
-            std::vector<real> in, out;
-
-            int nthreads  = gmx_omp_get_max_threads();
-            int thread_id = gmx_omp_get_thread_num();
-            int i0        = (thread_id * nfunc) / nthreads;
-            int i1        = std::min(nfunc, ((thread_id + 1) * nfunc) / nthreads);
-
-            gmx_fft_init_1d(&fft1, nfft, GMX_FFT_FLAG_CONSERVATIVE);
-            /* Allocate temporary arrays */
-            in.resize(2 * nfft, 0);
-            out.resize(2 * nfft, 0);
-            for (int i = i0; (i < i1); i++)
-            {
-                for (size_t j = 0; j < ndata; j++)
-                {
-                    in[2 * j + 0] = (*c)[i][j];
-                    in[2 * j + 1] = 0;
-                }
-                gmx_fft_1d(fft1, GMX_FFT_BACKWARD, in.data(), out.data());
-                for (size_t j = 0; j < nfft; j++)
-                {
-                    in[2 * j + 0] =
-                            (out[2 * j + 0] * out[2 * j + 0] + out[2 * j + 1] * out[2 * j + 1]) / nfft;
-                    in[2 * j + 1] = 0;
-                }
-                gmx_fft_1d(fft1, GMX_FFT_FORWARD, in.data(), out.data());
-                for (size_t j = 0; (j < nfft); j++)
-                {
-                    (*c)[i][j] = out[2 * j + 0];
-                }
-            }
-            /* Free the memory */
-            gmx_fft_destroy(fft1);
-        }
-        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
-    }
-    for (auto& i : *c)
+
+    gmx::ManyAutoCorrelation correlation(ndata, gmx_omp_get_max_threads());
+    correlation.compute(series);
+
+    for (size_t i = 0; i < nfunc; i++)
     {
-        i.resize(ndata);
+        std::copy(series.begin() + i * ndata, series.begin() + (i + 1) * ndata, (*c)[i].begin());
     }
 
     return 0;
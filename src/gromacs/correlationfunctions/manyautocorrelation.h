@@ -47,6 +47,8 @@
 #include <vector>
 
 #include "gromacs/fft/fft.h"
+#include "gromacs/utility/arrayref.h"
+#include "gromacs/utility/classhelpers.h"
 #include "gromacs/utility/real.h"
 
 /*! \brief
@@ -62,7 +64,8 @@
  * The c arrays will be extend and filled with zero beyond ndata before
  * computing the correlation.
  *
- * The functions uses OpenMP parallellization.
+ * The functions uses OpenMP parallellization. When computing correlations
+ * repeatedly, use gmx::ManyAutoCorrelation, which sets up the transforms once.
  *
  * \param[inout] c Data array
  * \return fft error code, or zero if everything went fine (see fft/fft.h)
@@ -70,4 +73,52 @@
  */
 int many_auto_correl(std::vector<std::vector<real>>* c);
 
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * Computes many autocorrelation functions of series of equal length.
+ *
+ * The FFT plans and work buffers are set up once, at construction, and are
+ * reused for all series passed to compute(). The series are copied to
+ * contiguous buffers in batches of a size that fits in cache and transformed
+ * with batched real-to-complex FFTs. The batches are divided over OpenMP
+ * threads. The results are the same as those of many_auto_correl().
+ *
+ * This is intended for use by all tools that compute autocorrelation
+ * functions of many series, e.g. per molecule.
+ */
+class ManyAutoCorrelation
+{
+public:
+    /*! \brief Sets up the transforms for series of \p numPoints values
+     *
+     * \param[in] numPoints  The number of values in each series
+     * \param[in] numThreads The number of OpenMP threads used in compute()
+     * \throws InconsistentInputError when \p numPoints is less than 1.
+     */
+    ManyAutoCorrelation(int numPoints, int numThreads);
+    ~ManyAutoCorrelation();
+
+    //! Returns the number of values in each series
+    int numPoints() const;
+
+    /*! \brief Replaces series by their autocorrelation functions
+     *
+     * As with many_auto_correl(), the functions are not normalized.
+     *
+     * \param[inout] series Series of numPoints() values each, stored consecutively
+     * \throws InconsistentInputError when the size of \p series is not
+     *         a multiple of numPoints().
+     */
+    void compute(ArrayRef<real> series);
+
+private:
+    class Impl;
+
+    PrivateImplPointer<Impl> impl_;
+};
+
+} // namespace gmx
+
 #endif
@@ -81,6 +81,54 @@ TEST_F(ManyAutocorrelationTest, DifferentLength)
 }
 #endif
 
+TEST_F(ManyAutocorrelationTest, ThrowsOnWrongSize)
+{
+    ManyAutoCorrelation correlation(10, 1);
+    std::vector<real>   series(25);
+    EXPECT_THROW_GMX(correlation.compute(series), gmx::InconsistentInputError);
+}
+
+TEST_F(ManyAutocorrelationTest, MatchesDirectSum)
+{
+    // Use more series than fit in a batch, so also the remainder is tested
+    const int numPoints = 100;
+    const int numSeries = 70;
+
+    std::vector<real> series(numPoints * numSeries);
+    for (int s = 0; s < numSeries; s++)
+    {
+        for (int i = 0; i < numPoints; i++)
+        {
+            series[s * numPoints + i] = std::cos(0.1 * (s + 1) * i) + 0.01 * s;
+        }
+    }
+    const std::vector<real> input = series;
+
+    ManyAutoCorrelation correlation(numPoints, 2);
+    EXPECT_EQ(numPoints, correlation.numPoints());
+    correlation.compute(series);
+    // Check that the plans can be reused
+    std::vector<real> seriesAgain = input;
+    correlation.compute(seriesAgain);
+
+    // The zero padding avoids periodic images up to half the series length
+    for (int s = 0; s < numSeries; s++)
+    {
+        for (int j = 0; j < numPoints / 2; j++)
+        {
+            real sum = 0;
+            for (int i = 0; i + j < numPoints; i++)
+            {
+                sum += input[s * numPoints + i] * input[s * numPoints + i + j];
+            }
+            EXPECT_REAL_EQ_TOL(sum, series[s * numPoints + j],
+                               test::relativeToleranceAsFloatingPoint(numPoints, 1e-4))
+                    << "series " << s << " lag " << j;
+            EXPECT_EQ(series[s * numPoints + j], seriesAgain[s * numPoints + j]);
+        }
+    }
+}
+
 } // namespace
 
 } // namespace gmx
@@ -43,7 +43,10 @@
 #include <cstdio>
 #include <cstring>
 
+#include <algorithm>
 #include <limits>
+#include <type_traits>
+#include <vector>
 
 #include "gromacs/fileio/gmxfio.h"
 #include "gromacs/fileio/xdrf.h"
@@ -51,6 +54,8 @@
 #include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/smalloc.h"
 
+#include "config.h"
+
 #include "gmxfio_impl.h"
 
 /* Enumerated for data types in files */
@@ -590,6 +595,88 @@ gmx_bool gmx_fio_doe_opaque(t_fileio* fio, char* data, std::size_t size, const c
     return ret;
 }
 
+/* Bulk reading of arrays
+ *
+ * XDR stores 32- and 64-bit integers and IEEE floating-point values as
+ * big-endian words of the same size. So instead of decoding an array value
+ * by value, we can read the raw bytes of the whole array with a single
+ * xdr_opaque call directly into the destination and, on little-endian hosts,
+ * swap the bytes of all words in a loop that the compiler vectorizes.
+ */
+
+/* Returns whether the bytes of a double are stored in the same order as in an integer */
+static bool doubleHasIntegerByteOrder()
+{
+    const double x = 0.987654321;
+    uint64_t     asInteger;
+    std::memcpy(&asInteger, &x, sizeof(x));
+    return asInteger == 0x3FEF9ADD3C0E56B8;
+}
+
+/* Returns whether n values can be read in bulk into item, fileTypeIsDouble tells
+ * whether the values are stored as doubles in the file */
+static bool canReadInBulk(const t_fileio* fio, const void* item, int n, bool fileTypeIsDouble)
+{
+    return fio->bRead && item != nullptr && n > 0
+           && (!fileTypeIsDouble || doubleHasIntegerByteOrder());
+}
+
+/* Reverses the byte order of each of the n words of type T stored in bytes */
+template<typename T>
+static void swapWordBytes(char* bytes, std::size_t n)
+{
+    using Word = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static_assert(sizeof(Word) == sizeof(T), "Can only swap 4- or 8-byte words");
+
+    for (std::size_t i = 0; i < n; i++)
+    {
+        Word word;
+        std::memcpy(&word, bytes + i * sizeof(Word), sizeof(Word));
+        Word swapped = 0;
+        for (std::size_t b = 0; b < sizeof(Word); b++)
+        {
+            swapped |= ((word >> (8 * b)) & 0xFF) << (8 * (sizeof(Word) - 1 - b));
+        }
+        std::memcpy(bytes + i * sizeof(Word), &swapped, sizeof(Word));
+    }
+}
+
+/* Reads n values stored in XDR format as type FileType into item,
+ * converting to the type of item when it differs.
+ */
+template<typename FileType, typename T>
+static gmx_bool readXdrArray(t_fileio* fio, T* item, std::size_t n)
+{
+    if (!std::is_same<FileType, T>::value)
+    {
+        std::vector<FileType> buffer(n);
+        if (!readXdrArray<FileType>(fio, buffer.data(), n))
+        {
+            return FALSE;
+        }
+        std::copy(buffer.begin(), buffer.end(), item);
+        return TRUE;
+    }
+
+    char*             bytes    = reinterpret_cast<char*>(item);
+    const std::size_t numBytes = n * sizeof(FileType);
+    /* xdr_opaque takes the byte count as an unsigned int */
+    constexpr std::size_t c_maxChunkSize = std::size_t(1) << 30;
+    for (std::size_t offset = 0; offset < numBytes; offset += c_maxChunkSize)
+    {
+        const std::size_t chunkSize = std::min(c_maxChunkSize, numBytes - offset);
+        if (!xdr_opaque(fio->xdr, bytes + offset, static_cast<unsigned int>(chunkSize)))
+        {
+            return FALSE;
+        }
+    }
+#if !GMX_INTEGER_BIG_ENDIAN
+    swapWordBytes<FileType>(bytes, n);
+#endif
+
+    return TRUE;
+}
+
 /* Array reading & writing */
 
 gmx_bool gmx_fio_ndoe_real(t_fileio* fio, real* item, int n, const char* desc, const char* srcfile, int line)
@@ -597,9 +684,16 @@ gmx_bool gmx_fio_ndoe_real(t_fileio* fio, real* item, int n, const char* desc, c
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, fio->bDouble))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioREAL, desc, srcfile, line);
+        ret = fio->bDouble ? readXdrArray<double>(fio, item, n) : readXdrArray<float>(fio, item, n);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioREAL, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -611,9 +705,16 @@ gmx_bool gmx_fio_ndoe_float(t_fileio* fio, float* item, int n, const char* desc,
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, false))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioFLOAT, desc, srcfile, line);
+        ret = readXdrArray<float>(fio, item, n);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioFLOAT, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -625,9 +726,16 @@ gmx_bool gmx_fio_ndoe_double(t_fileio* fio, double* item, int n, const char* des
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, true))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioDOUBLE, desc, srcfile, line);
+        ret = readXdrArray<double>(fio, item, n);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioDOUBLE, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -663,9 +771,16 @@ gmx_bool gmx_fio_ndoe_int(t_fileio* fio, int* item, int n, const char* desc, con
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, false))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioINT, desc, srcfile, line);
+        ret = readXdrArray<int32_t>(fio, item, n);
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioINT, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -677,9 +792,16 @@ gmx_bool gmx_fio_ndoe_int64(t_fileio* fio, int64_t* item, int n, const char* des
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, false))
+    {
+        ret = readXdrArray<int64_t>(fio, item, n);
+    }
+    else
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioINT64, desc, srcfile, line);
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioINT64, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -723,7 +845,16 @@ gmx_bool gmx_fio_ndoe_rvec(t_fileio* fio, rvec* item, int n, const char* desc, c
 {
     gmx_bool ret = TRUE;
     gmx_fio_lock(fio);
-    ret = ret && do_xdr(fio, item, n, eioNRVEC, desc, srcfile, line);
+    if (canReadInBulk(fio, item, n, fio->bDouble))
+    {
+        const std::size_t numValues = DIM * static_cast<std::size_t>(n);
+        ret = fio->bDouble ? readXdrArray<double>(fio, item[0], numValues)
+                           : readXdrArray<float>(fio, item[0], numValues);
+    }
+    else
+    {
+        ret = ret && do_xdr(fio, item, n, eioNRVEC, desc, srcfile, line);
+    }
     gmx_fio_unlock(fio);
     return ret;
 }
@@ -734,9 +865,16 @@ gmx_bool gmx_fio_ndoe_ivec(t_fileio* fio, ivec* item, int n, const char* desc, c
     gmx_bool ret = TRUE;
     int      i;
     gmx_fio_lock(fio);
-    for (i = 0; i < n; i++)
+    if (canReadInBulk(fio, item, n, false))
     {
-        ret = ret && do_xdr(fio, &(item[i]), 1, eioIVEC, desc, srcfile, line);
+        ret = readXdrArray<int32_t>(fio, item[0], DIM * static_cast<std::size_t>(n));
+    }
+    else
+    {
+        for (i = 0; i < n; i++)
+        {
+            ret = ret && do_xdr(fio, &(item[i]), 1, eioIVEC, desc, srcfile, line);
+        }
     }
     gmx_fio_unlock(fio);
     return ret;
@@ -839,6 +977,26 @@ void FileIOXdrSerializer::doUCharArray(unsigned char* values, int elements)
     gmx_fio_ndo_uchar(fio_, values, elements);
 }
 
+void FileIOXdrSerializer::doIntArray(int* values, int elements)
+{
+    gmx_fio_ndo_int(fio_, values, elements);
+}
+
+void FileIOXdrSerializer::doInt64Array(int64_t* values, int elements)
+{
+    gmx_fio_ndo_int64(fio_, values, elements);
+}
+
+void FileIOXdrSerializer::doFloatArray(float* values, int elements)
+{
+    gmx_fio_ndo_float(fio_, values, elements);
+}
+
+void FileIOXdrSerializer::doDoubleArray(double* values, int elements)
+{
+    gmx_fio_ndo_double(fio_, values, elements);
+}
+
 void FileIOXdrSerializer::doRvecArray(rvec* values, int elements)
 {
     gmx_fio_ndo_rvec(fio_, values, elements);
@@ -46,6 +46,7 @@
 
 #include "gromacs/fileio/gmxfio.h"
 #include "gromacs/fileio/gmxfio_xdr.h"
+#include "gromacs/math/vectypes.h"
 #include "gromacs/utility/futil.h"
 
 #include "testutils/testfilemanager.h"
@@ -145,6 +146,87 @@ TEST_F(FileIOXdrSerializerTest, SizeIsCorrect)
     EXPECT_EQ(fileSize, 72);
 }
 
+TEST_F(FileIOXdrSerializerTest, ArraysReadInBulkMatchValues)
+{
+    std::vector<real>    realValues   = { 1.5, -2.25, 3.125e-3, 4e5, 0 };
+    std::vector<float>   floatValues  = { -1.5F, 2.25e3F, 7.0F };
+    std::vector<double>  doubleValues = { 1.0 / 3.0, -2.5e-100, 1e300 };
+    std::vector<int>     intValues    = { 0, -1, 0x78ABCDEF, 42 };
+    std::vector<int64_t> int64Values  = { c_int64Value, -2, 0 };
+    std::vector<RVec>    rvecValues   = { { 1, 2, 3 }, { -4.5, 5.25, -6.125 } };
+    std::vector<IVec>    ivecValues   = { { 1, -2, 3 }, { 0x7ABCDEF0, 5, -6 } };
+
+    // Test reading real values stored in single and double precision
+    for (bool writeDouble : { false, true })
+    {
+        // Write the values with the non-bulk code path
+        file_ = gmx_fio_open(filename_.c_str(), "w");
+        gmx_fio_setprecision(file_, writeDouble);
+        for (real& value : realValues)
+        {
+            gmx_fio_do_real(file_, value);
+        }
+        for (float& value : floatValues)
+        {
+            gmx_fio_do_float(file_, value);
+        }
+        for (double& value : doubleValues)
+        {
+            gmx_fio_do_double(file_, value);
+        }
+        for (int& value : intValues)
+        {
+            gmx_fio_do_int(file_, value);
+        }
+        for (int64_t& value : int64Values)
+        {
+            gmx_fio_do_int64(file_, value);
+        }
+        for (RVec& value : rvecValues)
+        {
+            gmx_fio_do_rvec(file_, value.as_vec());
+        }
+        for (IVec& value : ivecValues)
+        {
+            gmx_fio_do_ivec(file_, value.as_vec());
+        }
+        gmx_fio_close(file_);
+
+        file_ = gmx_fio_open(filename_.c_str(), "r");
+        gmx_fio_setprecision(file_, writeDouble);
+        std::vector<real>    realResult(realValues.size());
+        std::vector<float>   floatResult(floatValues.size());
+        std::vector<double>  doubleResult(doubleValues.size());
+        std::vector<int>     intResult(intValues.size());
+        std::vector<int64_t> int64Result(int64Values.size());
+        std::vector<RVec>    rvecResult(rvecValues.size());
+        std::vector<IVec>    ivecResult(ivecValues.size());
+        EXPECT_TRUE(gmx_fio_ndo_real(file_, realResult.data(), realResult.size()));
+        EXPECT_TRUE(gmx_fio_ndo_float(file_, floatResult.data(), floatResult.size()));
+        EXPECT_TRUE(gmx_fio_ndo_double(file_, doubleResult.data(), doubleResult.size()));
+        EXPECT_TRUE(gmx_fio_ndo_int(file_, intResult.data(), intResult.size()));
+        EXPECT_TRUE(gmx_fio_ndo_int64(file_, int64Result.data(), int64Result.size()));
+        EXPECT_TRUE(gmx_fio_ndo_rvec(file_, as_rvec_array(rvecResult.data()), rvecResult.size()));
+        EXPECT_TRUE(gmx_fio_ndo_ivec(file_, as_vec_array(ivecResult.data()), ivecResult.size()));
+        gmx_fio_close(file_);
+        file_ = nullptr;
+
+        EXPECT_EQ(realValues, realResult);
+        EXPECT_EQ(floatValues, floatResult);
+        EXPECT_EQ(doubleValues, doubleResult);
+        EXPECT_EQ(intValues, intResult);
+        EXPECT_EQ(int64Values, int64Result);
+        for (size_t i = 0; i < rvecValues.size(); i++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                EXPECT_EQ(rvecValues[i][d], rvecResult[i][d]);
+                EXPECT_EQ(ivecValues[i][d], ivecResult[i][d]);
+            }
+        }
+    }
+}
+
 } // namespace
 } // namespace test
 } // namespace gmx
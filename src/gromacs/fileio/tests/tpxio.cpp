@@ -0,0 +1,185 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for reading and writing run input files.
+ *
+ * \ingroup module_fileio
+ */
+#include "gmxpre.h"
+
+#include "gromacs/fileio/tpxio.h"
+
+#include <algorithm>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/state.h"
+#include "gromacs/topology/topology.h"
+#include "gromacs/utility/enumerationhelpers.h"
+#include "gromacs/utility/futil.h"
+#include "gromacs/utility/textreader.h"
+
+#include "testutils/testfilemanager.h"
+#include "testutils/tprfilegenerator.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+class TpxIoTest : public ::testing::Test
+{
+protected:
+    //! Prepare shared resources.
+    static void SetUpTestCase() { s_tprFileHandle = new TprAndFileManager("lysozyme"); }
+    //! Clean up shared resources.
+    static void TearDownTestCase()
+    {
+        delete s_tprFileHandle;
+        s_tprFileHandle = nullptr;
+    }
+    //! Returns the text dump of \p ir and \p mtop, for comparing them as a whole
+    std::string dumpInputrecAndTopology(const t_inputrec& ir, const gmx_mtop_t& mtop)
+    {
+        const std::string dumpFileName = fileManager_.getTemporaryFilePath("dump.txt");
+        FILE*             fp           = gmx_ffopen(dumpFileName, "w");
+        pr_inputrec(fp, 0, "inputrec", &ir, FALSE);
+        pr_mtop(fp, 0, "topology", &mtop, TRUE, TRUE);
+        gmx_ffclose(fp);
+        return TextReader::readFileToString(dumpFileName);
+    }
+    //! Storage for opened file handles.
+    static TprAndFileManager* s_tprFileHandle;
+    //! Manages the dump files.
+    TestFileManager fileManager_;
+};
+
+TprAndFileManager* TpxIoTest::s_tprFileHandle = nullptr;
+
+TEST_F(TpxIoTest, ReadingInputrecAndTopologyMatchesReadingTheState)
+{
+    const char* tprFileName = s_tprFileHandle->tprName().c_str();
+
+    t_inputrec                 stateInputrec;
+    t_state                    state;
+    gmx_mtop_t                 stateMtop;
+    PartialDeserializedTprFile partialDeserializedTpr =
+            read_tpx_state(tprFileName, &stateInputrec, &state, &stateMtop);
+
+    t_inputrec inputrec;
+    gmx_mtop_t mtop;
+    PbcType    pbcType = readTprInputrecAndTopology(tprFileName, &inputrec, &mtop);
+
+    EXPECT_EQ(partialDeserializedTpr.pbcType, pbcType);
+    EXPECT_EQ(dumpInputrecAndTopology(stateInputrec, stateMtop),
+              dumpInputrecAndTopology(inputrec, mtop));
+}
+
+TEST_F(TpxIoTest, ReadingWithoutBroadcastMatchesReadingTheState)
+{
+    const char* tprFileName = s_tprFileHandle->tprName().c_str();
+
+    t_inputrec                 referenceInputrec;
+    t_state                    referenceState;
+    gmx_mtop_t                 referenceMtop;
+    PartialDeserializedTprFile partialDeserializedTpr =
+            read_tpx_state(tprFileName, &referenceInputrec, &referenceState, &referenceMtop);
+
+    t_inputrec inputrec;
+    t_state    state;
+    gmx_mtop_t mtop;
+    PbcType    pbcType = readTpxStateWithoutBroadcast(tprFileName, &inputrec, &state, &mtop);
+
+    EXPECT_EQ(partialDeserializedTpr.pbcType, pbcType);
+    EXPECT_EQ(dumpInputrecAndTopology(referenceInputrec, referenceMtop),
+              dumpInputrecAndTopology(inputrec, mtop));
+    ASSERT_EQ(referenceState.natoms, state.natoms);
+    for (int i = 0; i < state.natoms; i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_EQ(referenceState.x[i][d], state.x[i][d]);
+        }
+    }
+}
+
+TEST_F(TpxIoTest, GroupNumbersSurviveWritingAndReading)
+{
+    const char* tprFileName = s_tprFileHandle->tprName().c_str();
+
+    t_inputrec inputrec;
+    t_state    state;
+    gmx_mtop_t mtop;
+    read_tpx_state(tprFileName, &inputrec, &state, &mtop);
+
+    /* Use runs of different lengths, including runs of a single atom at
+     * the start and the end, and leave one group type at its default
+     * of no stored group numbers.
+     */
+    auto& groupNumbers   = mtop.groups.groupNumbers;
+    auto& tcGroupNumbers = groupNumbers[SimulationAtomGroupType::TemperatureCoupling];
+    tcGroupNumbers.assign(mtop.natoms, 1);
+    tcGroupNumbers[0]               = 0;
+    tcGroupNumbers[mtop.natoms / 2] = 2;
+    tcGroupNumbers[mtop.natoms - 1] = 0;
+
+    auto& energyGroupNumbers = groupNumbers[SimulationAtomGroupType::EnergyOutput];
+    energyGroupNumbers.assign(mtop.natoms, 0);
+    std::fill(energyGroupNumbers.begin() + mtop.natoms / 3, energyGroupNumbers.end(), 1);
+    groupNumbers[SimulationAtomGroupType::Freeze].clear();
+
+    const std::string writtenTprFileName = fileManager_.getTemporaryFilePath("written.tpr");
+    write_tpx_state(writtenTprFileName.c_str(), &inputrec, &state, &mtop);
+
+    t_inputrec readInputrec;
+    t_state    readState;
+    gmx_mtop_t readMtop;
+    read_tpx_state(writtenTprFileName.c_str(), &readInputrec, &readState, &readMtop);
+
+    for (auto group : keysOf(groupNumbers))
+    {
+        SCOPED_TRACE(std::string("For group type ") + shortName(group));
+        EXPECT_EQ(groupNumbers[group], readMtop.groups.groupNumbers[group]);
+    }
+}
+
+} // namespace
+} // namespace test
+} // namespace gmx
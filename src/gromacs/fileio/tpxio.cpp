@@ -134,6 +134,7 @@ enum tpxv
     tpxv_StoreNonBondedInteractionExclusionGroup, /**< Store the non bonded interaction exclusion group in the topology */
     tpxv_VSite1,                                  /**< Added 1 type virtual site */
     tpxv_MTS,                                     /**< Added multiple time stepping */
+    tpxv_RunLengthEncodedGroupNumbers,            /**< Store per-atom group numbers run-length encoded */
     tpxv_Count                                    /**< the total number of tpxv versions */
 };
 
@@ -165,8 +166,10 @@ static const int tpx_version = tpxv_Count - 1;
  * ftupd, so that old code can read new .tpr files.
  *
  * Updated for added field that contains the number of bytes of the tpr body, excluding the header.
+ *
+ * Updated for run-length encoded storage of the per-atom group numbers.
  */
-static const int tpx_generation = 27;
+static const int tpx_generation = 28;
 
 /* This number should be the most recent backwards incompatible version
  * I.e., if this number is 9, we cannot read tpx version 9 with this code.
@@ -2328,7 +2331,65 @@ static void do_atoms(gmx::ISerializer* serializer, t_atoms* atoms, t_symtab* sym
     do_resinfo(serializer, atoms->nres, atoms->resinfo, symtab, file_version);
 }
 
-static void do_groups(gmx::ISerializer* serializer, SimulationGroups* groups, t_symtab* symtab)
+/*! \brief Serialize the per-atom group numbers of one group type as runs
+ *
+ * Group numbers are nearly always constant over long stretches of atoms,
+ * so we store pairs of (group number, run length) instead of one value
+ * per atom. The total number of entries is stored first, so a reader
+ * can size the array before expanding the runs.
+ */
+static void do_groupNumbersRunLengthEncoded(gmx::ISerializer* serializer, std::vector<unsigned char>* groupNumbers)
+{
+    int numberOfGroupNumbers = groupNumbers->size();
+    serializer->doInt(&numberOfGroupNumbers);
+    if (numberOfGroupNumbers == 0)
+    {
+        return;
+    }
+
+    std::vector<unsigned char> runValues;
+    std::vector<int>           runLengths;
+    if (!serializer->reading())
+    {
+        for (const unsigned char groupNumber : *groupNumbers)
+        {
+            if (runValues.empty() || runValues.back() != groupNumber)
+            {
+                runValues.push_back(groupNumber);
+                runLengths.push_back(0);
+            }
+            runLengths.back()++;
+        }
+    }
+    int numRuns = runValues.size();
+    serializer->doInt(&numRuns);
+    if (serializer->reading())
+    {
+        runValues.resize(numRuns);
+        runLengths.resize(numRuns);
+    }
+    serializer->doUCharArray(runValues.data(), numRuns);
+    serializer->doIntArray(runLengths.data(), numRuns);
+
+    if (serializer->reading())
+    {
+        groupNumbers->clear();
+        groupNumbers->reserve(numberOfGroupNumbers);
+        for (int run = 0; run < numRuns; run++)
+        {
+            groupNumbers->insert(groupNumbers->end(), runLengths[run], runValues[run]);
+        }
+        if (gmx::ssize(*groupNumbers) != numberOfGroupNumbers)
+        {
+            gmx_fatal(FARGS,
+                      "Corrupt tpr file: run-length encoded group numbers expand to %zu "
+                      "entries, expected %d",
+                      groupNumbers->size(), numberOfGroupNumbers);
+        }
+    }
+}
+
+static void do_groups(gmx::ISerializer* serializer, SimulationGroups* groups, t_symtab* symtab, int file_version)
 {
     do_grps(serializer, groups->groups);
     int numberOfGroupNames = groups->groupNames.size();
@@ -2340,6 +2401,11 @@ static void do_groups(gmx::ISerializer* serializer, SimulationGroups* groups, t_
     do_strstr(serializer, numberOfGroupNames, groups->groupNames.data(), symtab);
     for (auto group : gmx::keysOf(groups->groupNumbers))
     {
+        if (file_version >= tpxv_RunLengthEncodedGroupNumbers)
+        {
+            do_groupNumbersRunLengthEncoded(serializer, &groups->groupNumbers[group]);
+            continue;
+        }
         int numberOfGroupNumbers = groups->numberOfGroupNumbers(group);
         serializer->doInt(&numberOfGroupNumbers);
         if (numberOfGroupNumbers != 0)
@@ -2599,7 +2665,7 @@ static void do_mtop(gmx::ISerializer* serializer, gmx_mtop_t* mtop, int file_ver
         mtop->ffparams.cmap_grid.cmapdata.clear();
     }
 
-    do_groups(serializer, &mtop->groups, &(mtop->symtab));
+    do_groups(serializer, &mtop->groups, &(mtop->symtab), file_version);
 
     mtop->haveMoleculeIndices = true;
 
@@ -2958,6 +3024,36 @@ static void do_tpx_state_second(gmx::ISerializer* serializer, TpxFileHeader* tpx
         serializer->doRvecArray(as_rvec_array(dummyForces.data()), tpx->natoms);
     }
 }
+/*! \brief
+ * Skip over the coordinate, velocity and force vectors of the state.
+ *
+ * Used when only the simulation parameters and topology are needed,
+ * so that no per-atom vectors get allocated. The vectors are consumed
+ * in chunks of fixed size.
+ *
+ * See the documentation for do_tpx_body for the correct order of
+ * the operations for reading a tpr file.
+ *
+ * \param[in] serializer Abstract serializer used to read data.
+ * \param[in] tpx The file header data.
+ */
+static void skip_tpx_state_second(gmx::ISerializer* serializer, const TpxFileHeader& tpx)
+{
+    GMX_RELEASE_ASSERT(serializer->reading(), "The state can only be skipped when reading");
+
+    constexpr int          c_chunkSize = 4096;
+    std::vector<gmx::RVec> chunk(std::min(c_chunkSize, tpx.natoms));
+    const int              numVectors = (tpx.bX ? 1 : 0) + (tpx.bV ? 1 : 0) + (tpx.bF ? 1 : 0);
+    for (int vector = 0; vector < numVectors; vector++)
+    {
+        for (int start = 0; start < tpx.natoms; start += c_chunkSize)
+        {
+            const int numElements = std::min(c_chunkSize, tpx.natoms - start);
+            serializer->doRvecArray(as_rvec_array(chunk.data()), numElements);
+        }
+    }
+}
+
 /*! \brief
  * Process simulation parameters.
  *
@@ -3199,6 +3295,8 @@ static void doTpxBodyBuffer(gmx::ISerializer* serializer, gmx::ArrayRef<char> bu
  * \param[out] x Coordinates to populate if needed.
  * \param[out] v Velocities to populate if needed.
  * \param[out] mtop Global topology to populate.
+ * \param[in] serializeForBroadcast Whether to serialize \p ir and \p mtop
+ *                                  for communication to other ranks.
  *
  * \returns Partial de-serialized TPR used for communication to nodes.
  */
@@ -3208,7 +3306,8 @@ static PartialDeserializedTprFile readTpxBody(TpxFileHeader*    tpx,
                                               t_state*          state,
                                               rvec*             x,
                                               rvec*             v,
-                                              gmx_mtop_t*       mtop)
+                                              gmx_mtop_t*       mtop,
+                                              bool              serializeForBroadcast)
 {
     PartialDeserializedTprFile partialDeserializedTpr;
     if (tpx->fileVersion >= tpxv_AddSizeField && tpx->fileGeneration >= 27)
@@ -3224,6 +3323,10 @@ static PartialDeserializedTprFile readTpxBody(TpxFileHeader*    tpx,
     {
         partialDeserializedTpr.pbcType = do_tpx_body(serializer, tpx, ir, state, x, v, mtop);
     }
+    if (!serializeForBroadcast)
+    {
+        return partialDeserializedTpr;
+    }
     // Update header to system info for communication to nodes.
     // As we only need to communicate the inputrec and mtop to other nodes,
     // we prepare a new char buffer with the information we have already read
@@ -3324,12 +3427,61 @@ PartialDeserializedTprFile read_tpx_state(const char* fn, t_inputrec* ir, t_stat
     gmx::FileIOXdrSerializer   serializer(fio);
     PartialDeserializedTprFile partialDeserializedTpr;
     do_tpxheader(&serializer, &partialDeserializedTpr.header, fn, fio, ir == nullptr);
-    partialDeserializedTpr =
-            readTpxBody(&partialDeserializedTpr.header, &serializer, ir, state, nullptr, nullptr, mtop);
+    partialDeserializedTpr = readTpxBody(&partialDeserializedTpr.header, &serializer, ir, state,
+                                         nullptr, nullptr, mtop, true);
     close_tpx(fio);
     return partialDeserializedTpr;
 }
 
+PbcType readTpxStateWithoutBroadcast(const char* fn,
+                                     t_inputrec* ir,
+                                     t_state*    state,
+                                     gmx_mtop_t* mtop)
+{
+    t_fileio*                fio = open_tpx(fn, "r");
+    gmx::FileIOXdrSerializer serializer(fio);
+    TpxFileHeader            tpx;
+    do_tpxheader(&serializer, &tpx, fn, fio, ir == nullptr);
+    PbcType pbcType =
+            readTpxBody(&tpx, &serializer, ir, state, nullptr, nullptr, mtop, false).pbcType;
+    close_tpx(fio);
+    return pbcType;
+}
+
+PbcType readTprInputrecAndTopology(const char* fn, t_inputrec* ir, gmx_mtop_t* mtop)
+{
+    t_fileio*                fio = open_tpx(fn, "r");
+    gmx::FileIOXdrSerializer serializer(fio);
+    TpxFileHeader            tpx;
+    do_tpxheader(&serializer, &tpx, fn, fio, ir == nullptr);
+    if (!(tpx.fileVersion >= tpxv_AddSizeField && tpx.fileGeneration >= 27))
+    {
+        // Old files have no size field, so we can not read the body as a block.
+        t_state state;
+        PbcType pbcType =
+                readTpxBody(&tpx, &serializer, ir, &state, nullptr, nullptr, mtop, false).pbcType;
+        close_tpx(fio);
+        return pbcType;
+    }
+
+    // Read the whole body with a single request, which is much friendlier
+    // to parallel file systems than many small reads.
+    std::vector<char> body(tpx.sizeOfTprBody);
+    doTpxBodyBuffer(&serializer, body);
+    close_tpx(fio);
+
+    gmx::InMemoryDeserializer tprBodyDeserializer(body, tpx.isDouble,
+                                                  gmx::EndianSwapBehavior::SwapIfHostIsLittleEndian);
+    t_state boxState;
+    do_tpx_state_first(&tprBodyDeserializer, &tpx, &boxState);
+    do_tpx_mtop(&tprBodyDeserializer, &tpx, mtop);
+    skip_tpx_state_second(&tprBodyDeserializer, tpx);
+    PbcType pbcType = do_tpx_ir(&tprBodyDeserializer, &tpx, ir);
+    do_tpx_finalize(&tpx, ir, nullptr, mtop);
+
+    return pbcType;
+}
+
 PbcType read_tpx(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec* x, rvec* v, gmx_mtop_t* mtop)
 {
     t_fileio* fio;
@@ -3340,7 +3492,7 @@ PbcType read_tpx(const char* fn, t_inputrec* ir, matrix box, int* natoms, rvec*
     gmx::FileIOXdrSerializer serializer(fio);
     do_tpxheader(&serializer, &tpx, fn, fio, ir == nullptr);
     PartialDeserializedTprFile partialDeserializedTpr =
-            readTpxBody(&tpx, &serializer, ir, &state, x, v, mtop);
+            readTpxBody(&tpx, &serializer, ir, &state, x, v, mtop, false);
     close_tpx(fio);
     if (mtop != nullptr && natoms != nullptr)
     {
@@ -188,6 +188,38 @@ PbcType completeTprDeserialization(PartialDeserializedTprFile* partialDeserializ
  */
 PartialDeserializedTprFile read_tpx_state(const char* fn, t_inputrec* ir, t_state* state, gmx_mtop_t* mtop);
 
+/*! \brief
+ * Read a file to set up a simulation, without preparing it for other ranks.
+ *
+ * As read_tpx_state(), but \p ir and \p mtop are not serialized again for
+ * communication, for use when the other ranks read the file themselves.
+ *
+ * \param[in] fn Input file name.
+ * \param[out] ir Input parameters to be set, or nullptr.
+ * \param[out] state State variables for the simulation.
+ * \param[out] mtop Global simulation topolgy.
+ * \returns PBC flag.
+ */
+PbcType readTpxStateWithoutBroadcast(const char* fn,
+                                     t_inputrec* ir,
+                                     t_state*    state,
+                                     gmx_mtop_t* mtop);
+
+/*! \brief
+ * Read only the simulation parameters and topology from a file.
+ *
+ * The body of the file is read with a single request and the
+ * coordinates and velocities it contains are skipped, so that no
+ * per-atom state is allocated. This lets ranks that do not hold
+ * the global state set up a simulation directly from the file.
+ *
+ * \param[in] fn Input file name.
+ * \param[out] ir Input parameters to be set.
+ * \param[out] mtop Global simulation topology.
+ * \returns PBC flag.
+ */
+PbcType readTprInputrecAndTopology(const char* fn, t_inputrec* ir, gmx_mtop_t* mtop);
+
 /*! \brief
  * Read a file and close it again.
  *
@@ -196,6 +196,264 @@ static inline RealType potSwitchPotentialMod(const RealType potentialInp,
 }
 
 
+//! Parameters of the pair potentials in the free-energy kernel
+struct PairPotentialParameters
+{
+    //! Constructor, extracts the parameters from \p ic
+    PairPotentialParameters(const interaction_const_t& ic) :
+        rcoulomb(ic.rcoulomb),
+        krf(ic.k_rf),
+        crf(ic.c_rf),
+        shEwald(ic.sh_ewald),
+        rvdw(ic.rvdw),
+        rvdwSwitch(ic.rvdw_switch),
+        repulsionShift(ic.repulsion_shift.cpot),
+        dispersionShift(ic.dispersion_shift.cpot),
+        shLjEwald(ic.sh_lj_ewald)
+    {
+        if (ic.vdw_modifier == eintmodPOTSWITCH)
+        {
+            const real d = ic.rvdw - ic.rvdw_switch;
+            vdw_swV3     = -10.0 / (d * d * d);
+            vdw_swV4     = 15.0 / (d * d * d * d);
+            vdw_swV5     = -6.0 / (d * d * d * d * d);
+            vdw_swF2     = -30.0 / (d * d * d);
+            vdw_swF3     = 60.0 / (d * d * d * d);
+            vdw_swF4     = -30.0 / (d * d * d * d * d);
+        }
+    }
+
+    //! Coulomb cut-off
+    real rcoulomb;
+    //! Reaction-field constant k
+    real krf;
+    //! Reaction-field constant c
+    real crf;
+    //! Ewald potential shift
+    real shEwald;
+    //! Van der Waals cut-off
+    real rvdw;
+    //! Van der Waals switching start distance
+    real rvdwSwitch;
+    //! LJ repulsion potential shift
+    real repulsionShift;
+    //! LJ dispersion potential shift
+    real dispersionShift;
+    //! LJ-PME grid potential shift
+    real shLjEwald;
+    //! LJ potential switch coefficients
+    real vdw_swV3 = 0, vdw_swV4 = 0, vdw_swV5 = 0, vdw_swF2 = 0, vdw_swF3 = 0, vdw_swF4 = 0;
+};
+
+/*! \brief Computes the Coulomb and Van der Waals potentials and scalar forces
+ * of a pair in one of the two states at the (soft-core) radii rC and rV
+ *
+ * The scalar forces are returned as dV/drC * rC^(1-p) and dV/drV * rV^(1-p),
+ * with p the soft-core power. Interactions beyond the cut-off are zero.
+ */
+template<bool useSoftCore, bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald, bool vdwModifierIsPotSwitch, class RealType>
+static inline void pairStatePotentials(const PairPotentialParameters& pp,
+                                       const RealType                 r,
+                                       const RealType                 qq,
+                                       const RealType                 c6,
+                                       const RealType                 c12,
+                                       const real                     c6grid,
+                                       const RealType                 rinvC,
+                                       const RealType                 rC,
+                                       const RealType                 rpinvC,
+                                       const RealType                 rinvV,
+                                       const RealType                 rV,
+                                       const RealType                 rpinvV,
+                                       RealType*                      Vcoul,
+                                       RealType*                      FscalC,
+                                       RealType*                      Vvdw,
+                                       RealType*                      FscalV)
+{
+    constexpr real onetwelfth = 1.0 / 12.0;
+    constexpr real onesixth   = 1.0 / 6.0;
+    constexpr real zero       = 0.0;
+    constexpr real one        = 1.0;
+    constexpr real two        = 2.0;
+
+    *Vcoul  = 0;
+    *FscalC = 0;
+    *Vvdw   = 0;
+    *FscalV = 0;
+
+    /* Only process the coulomb interactions if we have charges,
+     * and if we either include all entries in the list (no cutoff
+     * used in the kernel), or if we are within the cutoff.
+     */
+    bool computeElecInteraction = (elecInteractionTypeIsEwald && r < pp.rcoulomb)
+                                  || (!elecInteractionTypeIsEwald && rC < pp.rcoulomb);
+
+    if ((qq != 0) && computeElecInteraction)
+    {
+        if (elecInteractionTypeIsEwald)
+        {
+            *Vcoul  = ewaldPotential(qq, rinvC, pp.shEwald);
+            *FscalC = ewaldScalarForce(qq, rinvC);
+        }
+        else
+        {
+            *Vcoul  = reactionFieldPotential(qq, rinvC, rC, pp.krf, pp.crf);
+            *FscalC = reactionFieldScalarForce(qq, rinvC, rC, pp.krf, two);
+        }
+    }
+
+    /* Only process the VDW interactions if we have
+     * some non-zero parameters, and if we either
+     * include all entries in the list (no cutoff used
+     * in the kernel), or if we are within the cutoff.
+     */
+    bool computeVdwInteraction = (vdwInteractionTypeIsEwald && r < pp.rvdw)
+                                 || (!vdwInteractionTypeIsEwald && rV < pp.rvdw);
+    if ((c6 != 0 || c12 != 0) && computeVdwInteraction)
+    {
+        RealType rinv6;
+        if (useSoftCore)
+        {
+            rinv6 = rpinvV;
+        }
+        else
+        {
+            rinv6 = calculateRinv6(rinvV);
+        }
+        RealType Vvdw6  = calculateVdw6(c6, rinv6);
+        RealType Vvdw12 = calculateVdw12(c12, rinv6);
+
+        *Vvdw = lennardJonesPotential(Vvdw6, Vvdw12, c6, c12, pp.repulsionShift,
+                                      pp.dispersionShift, onesixth, onetwelfth);
+        *FscalV = lennardJonesScalarForce(Vvdw6, Vvdw12);
+
+        if (vdwInteractionTypeIsEwald)
+        {
+            /* Subtract the grid potential at the cut-off */
+            *Vvdw += ewaldLennardJonesGridSubtract(c6grid, pp.shLjEwald, onesixth);
+        }
+
+        if (vdwModifierIsPotSwitch)
+        {
+            RealType d        = rV - pp.rvdwSwitch;
+            d                 = (d > zero) ? d : zero;
+            const RealType d2 = d * d;
+            const RealType sw = one + d2 * d * (pp.vdw_swV3 + d * (pp.vdw_swV4 + d * pp.vdw_swV5));
+            const RealType dsw = d2 * (pp.vdw_swF2 + d * (pp.vdw_swF3 + d * pp.vdw_swF4));
+
+            *FscalV = potSwitchScalarForceMod(*FscalV, *Vvdw, sw, rV, pp.rvdw, dsw, zero);
+            *Vvdw   = potSwitchPotentialMod(*Vvdw, sw, rV, pp.rvdw, zero);
+        }
+    }
+
+    /* FscalC (and FscalV) now contain: dV/drC * rC
+     * Now we multiply by rC^-p, so it will be: dV/drC * rC^1-p
+     * Further down we first multiply by r^p-2 and then by
+     * the vector r, which in total gives: dV/drC * (r/rC)^1-p
+     */
+    *FscalC *= rpinvC;
+    *FscalV *= rpinvV;
+}
+
+/*! \brief Adds the energies and dV/dlambda at all lambda values in \p kernelData
+ *
+ * The soft-core pairs are evaluated for each lambda value, the sums over
+ * the other interactions, which depend linearly on lambda, are combined
+ * with the lambda factors.
+ *
+ * \param[in]     pp              Pair potential parameters
+ * \param[in]     ic              Interaction constants
+ * \param[in]     softCorePairs   The pairs with soft-core interactions
+ * \param[in]     linearCoul      The Coulomb potentials of the other interactions, per state
+ * \param[in]     linearVdw       The VdW potentials of the other interactions, per state
+ * \param[in,out] kernelData      Contains the lambda values and the output buffers
+ */
+template<bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald, bool vdwModifierIsPotSwitch>
+static void addEnergiesAtLambdas(const PairPotentialParameters& pp,
+                                 const interaction_const_t&     ic,
+                                 const SoftCorePairs&           softCorePairs,
+                                 const real                     linearCoul[2],
+                                 const real                     linearVdw[2],
+                                 const nb_kernel_data_t&        kernelData)
+{
+    constexpr real one        = 1.0;
+    constexpr real sc_r_power = 6.0_real;
+    const real     DLF[2]     = { -1, 1 };
+
+    const auto& scParams   = *ic.softCoreParameters;
+    const real  alpha_coul = scParams.alphaCoulomb;
+    const real  alpha_vdw  = scParams.alphaVdw;
+    const real  lam_power  = scParams.lambdaPower;
+
+    for (int l = 0; l < kernelData.numForeignLambdas; l++)
+    {
+        const real lambdaCoul    = kernelData.foreignLambdaCoul[l];
+        const real lambdaVdw     = kernelData.foreignLambdaVdw[l];
+        const bool scRadiiDiffer = (alpha_coul != alpha_vdw || lambdaCoul != lambdaVdw);
+
+        real energy = 0;
+        real dvdl   = 0;
+        for (int i = 0; i < 2; i++)
+        {
+            /* The lambda factors, as in nb_free_energy_kernel() */
+            const real LFC       = (i == 0 ? one - lambdaCoul : lambdaCoul);
+            const real LFV       = (i == 0 ? one - lambdaVdw : lambdaVdw);
+            const real lfacCoul  = (lam_power == 2 ? (1 - LFC) * (1 - LFC) : (1 - LFC));
+            const real dlfacCoul =
+                    DLF[i] * lam_power / sc_r_power * (lam_power == 2 ? (1 - LFC) : 1);
+            const real lfacVdw   = (lam_power == 2 ? (1 - LFV) * (1 - LFV) : (1 - LFV));
+            const real dlfacVdw =
+                    DLF[i] * lam_power / sc_r_power * (lam_power == 2 ? (1 - LFV) : 1);
+
+            energy += LFC * linearCoul[i] + LFV * linearVdw[i];
+            dvdl += DLF[i] * (linearCoul[i] + linearVdw[i]);
+
+            const real* r      = softCorePairs.r.data();
+            const real* rp     = softCorePairs.rp.data();
+            const real* qq     = softCorePairs.qq[i].data();
+            const real* c6     = softCorePairs.c6[i].data();
+            const real* c12    = softCorePairs.c12[i].data();
+            const real* sigma6 = softCorePairs.sigma6[i].data();
+            const real* c6grid = softCorePairs.c6grid[i].data();
+            for (int p = 0; p < softCorePairs.size(); p++)
+            {
+                if ((qq[p] == 0) && (c6[p] == 0) && (c12[p] == 0))
+                {
+                    continue;
+                }
+
+                real       rinvC, rC, rinvV, rV, rpinvV;
+                const real rpinvC = one / (alpha_coul * lfacCoul * sigma6[p] + rp[p]);
+                pthRoot(rpinvC, &rinvC, &rC);
+                if (scRadiiDiffer)
+                {
+                    rpinvV = one / (alpha_vdw * lfacVdw * sigma6[p] + rp[p]);
+                    pthRoot(rpinvV, &rinvV, &rV);
+                }
+                else
+                {
+                    rpinvV = rpinvC;
+                    rinvV  = rinvC;
+                    rV     = rC;
+                }
+
+                real Vcoul, FscalC, Vvdw, FscalV;
+                pairStatePotentials<true, vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, vdwModifierIsPotSwitch>(
+                        pp, r[p], qq[p], c6[p], c12[p], c6grid[p], rinvC, rC, rpinvC, rinvV, rV,
+                        rpinvV, &Vcoul, &FscalC, &Vvdw, &FscalV);
+
+                energy += LFC * Vcoul + LFV * Vvdw;
+                dvdl += (Vcoul + Vvdw) * DLF[i] + LFC * alpha_coul * dlfacCoul * FscalC * sigma6[p]
+                        + LFV * alpha_vdw * dlfacVdw * FscalV * sigma6[p];
+            }
+        }
+
+#pragma omp atomic
+        kernelData.foreignEnergies[l] += energy;
+#pragma omp atomic
+        kernelData.foreignDvdl[l] += dvdl;
+    }
+}
+
 //! Templated free-energy non-bonded kernel
 template<typename DataTypes, bool useSoftCore, bool scLambdasOrAlphasDiffer, bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald, bool vdwModifierIsPotSwitch>
 static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
@@ -204,6 +462,7 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                                   const t_forcerec* gmx_restrict fr,
                                   const t_mdatoms* gmx_restrict mdatoms,
                                   nb_kernel_data_t* gmx_restrict kernel_data,
+                                  SoftCorePairs*                 softCorePairsBuffer,
                                   t_nrnb* gmx_restrict nrnb)
 {
 #define STATE_A 0
@@ -214,13 +473,11 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     using IntType  = typename DataTypes::IntType;
 
     /* FIXME: How should these be handled with SIMD? */
-    constexpr real onetwelfth = 1.0 / 12.0;
-    constexpr real onesixth   = 1.0 / 6.0;
-    constexpr real zero       = 0.0;
-    constexpr real half       = 0.5;
-    constexpr real one        = 1.0;
-    constexpr real two        = 2.0;
-    constexpr real six        = 6.0;
+    constexpr real zero = 0.0;
+    constexpr real half = 0.5;
+    constexpr real one  = 1.0;
+    constexpr real two  = 2.0;
+    constexpr real six  = 6.0;
 
     /* Extract pointer to non-bonded interaction constants */
     const interaction_const_t* ic = fr->ic;
@@ -257,36 +514,18 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     const bool  doPotential   = ((kernel_data->flags & GMX_NONBONDED_DO_POTENTIAL) != 0);
 
     // Extract data from interaction_const_t
-    const real facel           = ic->epsfac;
-    const real rcoulomb        = ic->rcoulomb;
-    const real krf             = ic->k_rf;
-    const real crf             = ic->c_rf;
-    const real sh_lj_ewald     = ic->sh_lj_ewald;
-    const real rvdw            = ic->rvdw;
-    const real dispersionShift = ic->dispersion_shift.cpot;
-    const real repulsionShift  = ic->repulsion_shift.cpot;
+    const real facel    = ic->epsfac;
+    const real rcoulomb = ic->rcoulomb;
+    const real krf      = ic->k_rf;
+    const real crf      = ic->c_rf;
+    const real rvdw     = ic->rvdw;
+
+    const PairPotentialParameters pairPotentialParameters(*ic);
 
     // Note that the nbnxm kernels do not support Coulomb potential switching at all
     GMX_ASSERT(ic->coulomb_modifier != eintmodPOTSWITCH,
                "Potential switching is not supported for Coulomb with FEP");
 
-    real vdw_swV3, vdw_swV4, vdw_swV5, vdw_swF2, vdw_swF3, vdw_swF4;
-    if (vdwModifierIsPotSwitch)
-    {
-        const real d = ic->rvdw - ic->rvdw_switch;
-        vdw_swV3     = -10.0 / (d * d * d);
-        vdw_swV4     = 15.0 / (d * d * d * d);
-        vdw_swV5     = -6.0 / (d * d * d * d * d);
-        vdw_swF2     = -30.0 / (d * d * d);
-        vdw_swF3     = 60.0 / (d * d * d * d);
-        vdw_swF4     = -30.0 / (d * d * d * d * d);
-    }
-    else
-    {
-        /* Avoid warnings from stupid compilers (looking at you, Clang!) */
-        vdw_swV3 = vdw_swV4 = vdw_swV5 = vdw_swF2 = vdw_swF3 = vdw_swF4 = 0.0;
-    }
-
     int icoul;
     if (ic->eeltype == eelCUT || EEL_RF(ic->eeltype))
     {
@@ -307,11 +546,6 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     real        coulombTableScaleInvHalf = 0;
     real        vdwTableScale            = 0;
     real        vdwTableScaleInvHalf     = 0;
-    real        sh_ewald                 = 0;
-    if (elecInteractionTypeIsEwald || vdwInteractionTypeIsEwald)
-    {
-        sh_ewald = ic->sh_ewald;
-    }
     if (elecInteractionTypeIsEwald)
     {
         const auto& coulombTables = *ic->coulombEwaldTables;
@@ -375,6 +609,15 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
     real* gmx_restrict f      = &(forceWithShiftForces->force()[0][0]);
     real* gmx_restrict fshift = &(forceWithShiftForces->shiftForces()[0][0]);
 
+    /* With foreign lambdas, the potentials that are linear in lambda are summed
+     * per state and the soft-core pairs are stored for evaluation at all lambdas.
+     */
+    const bool     doForeignLambdas    = (kernel_data->numForeignLambdas > 0);
+    real           linearCoul[NSTATES] = { 0, 0 };
+    real           linearVdw[NSTATES]  = { 0, 0 };
+    SoftCorePairs& softCorePairs       = *softCorePairsBuffer;
+    softCorePairs.clear();
+
     for (int n = 0; n < nri; n++)
     {
         int npair_within_cutoff = 0;
@@ -557,83 +800,34 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                             rV     = r;
                         }
 
-                        /* Only process the coulomb interactions if we have charges,
-                         * and if we either include all entries in the list (no cutoff
-                         * used in the kernel), or if we are within the cutoff.
-                         */
-                        bool computeElecInteraction = (elecInteractionTypeIsEwald && r < rcoulomb)
-                                                      || (!elecInteractionTypeIsEwald && rC < rcoulomb);
+                        pairStatePotentials<useSoftCore, vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, vdwModifierIsPotSwitch>(
+                                pairPotentialParameters, r, qq[i], c6[i], c12[i],
+                                vdwInteractionTypeIsEwald ? nbfp_grid[tj[i]] : zero, rinvC, rC,
+                                rpinvC, rinvV, rV, rpinvV, &Vcoul[i], &FscalC[i], &Vvdw[i],
+                                &FscalV[i]);
+                    }
+                } // end for (int i = 0; i < NSTATES; i++)
 
-                        if ((qq[i] != 0) && computeElecInteraction)
+                if (doForeignLambdas)
+                {
+                    if (useSoftCore && alpha_coul_eff + alpha_vdw_eff != 0)
+                    {
+                        real c6grid[NSTATES];
+                        for (int i = 0; i < NSTATES; i++)
                         {
-                            if (elecInteractionTypeIsEwald)
-                            {
-                                Vcoul[i]  = ewaldPotential(qq[i], rinvC, sh_ewald);
-                                FscalC[i] = ewaldScalarForce(qq[i], rinvC);
-                            }
-                            else
-                            {
-                                Vcoul[i]  = reactionFieldPotential(qq[i], rinvC, rC, krf, crf);
-                                FscalC[i] = reactionFieldScalarForce(qq[i], rinvC, rC, krf, two);
-                            }
+                            c6grid[i] = vdwInteractionTypeIsEwald ? nbfp_grid[tj[i]] : zero;
                         }
-
-                        /* Only process the VDW interactions if we have
-                         * some non-zero parameters, and if we either
-                         * include all entries in the list (no cutoff used
-                         * in the kernel), or if we are within the cutoff.
-                         */
-                        bool computeVdwInteraction = (vdwInteractionTypeIsEwald && r < rvdw)
-                                                     || (!vdwInteractionTypeIsEwald && rV < rvdw);
-                        if ((c6[i] != 0 || c12[i] != 0) && computeVdwInteraction)
+                        softCorePairs.add(r, rp, qq, c6, c12, sigma6, c6grid);
+                    }
+                    else
+                    {
+                        for (int i = 0; i < NSTATES; i++)
                         {
-                            RealType rinv6;
-                            if (useSoftCore)
-                            {
-                                rinv6 = rpinvV;
-                            }
-                            else
-                            {
-                                rinv6 = calculateRinv6(rinvV);
-                            }
-                            RealType Vvdw6  = calculateVdw6(c6[i], rinv6);
-                            RealType Vvdw12 = calculateVdw12(c12[i], rinv6);
-
-                            Vvdw[i] = lennardJonesPotential(Vvdw6, Vvdw12, c6[i], c12[i], repulsionShift,
-                                                            dispersionShift, onesixth, onetwelfth);
-                            FscalV[i] = lennardJonesScalarForce(Vvdw6, Vvdw12);
-
-                            if (vdwInteractionTypeIsEwald)
-                            {
-                                /* Subtract the grid potential at the cut-off */
-                                Vvdw[i] += ewaldLennardJonesGridSubtract(nbfp_grid[tj[i]],
-                                                                         sh_lj_ewald, onesixth);
-                            }
-
-                            if (vdwModifierIsPotSwitch)
-                            {
-                                RealType d        = rV - ic->rvdw_switch;
-                                d                 = (d > zero) ? d : zero;
-                                const RealType d2 = d * d;
-                                const RealType sw =
-                                        one + d2 * d * (vdw_swV3 + d * (vdw_swV4 + d * vdw_swV5));
-                                const RealType dsw = d2 * (vdw_swF2 + d * (vdw_swF3 + d * vdw_swF4));
-
-                                FscalV[i] = potSwitchScalarForceMod(FscalV[i], Vvdw[i], sw, rV,
-                                                                    rvdw, dsw, zero);
-                                Vvdw[i]   = potSwitchPotentialMod(Vvdw[i], sw, rV, rvdw, zero);
-                            }
+                            linearCoul[i] += Vcoul[i];
+                            linearVdw[i] += Vvdw[i];
                         }
-
-                        /* FscalC (and FscalV) now contain: dV/drC * rC
-                         * Now we multiply by rC^-p, so it will be: dV/drC * rC^1-p
-                         * Further down we first multiply by r^p-2 and then by
-                         * the vector r, which in total gives: dV/drC * (r/rC)^1-p
-                         */
-                        FscalC[i] *= rpinvC;
-                        FscalV[i] *= rpinvV;
                     }
-                } // end for (int i = 0; i < NSTATES; i++)
+                }
 
                 /* Assemble A and B states */
                 for (int i = 0; i < NSTATES; i++)
@@ -677,6 +871,7 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                     vctot += LFC[i] * qq[i] * VV;
                     Fscal += LFC[i] * qq[i] * FF;
                     dvdl_coul += DLF[i] * qq[i] * VV;
+                    linearCoul[i] += qq[i] * VV;
                 }
             }
 
@@ -719,6 +914,7 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                     vctot -= LFC[i] * qq[i] * v_lr;
                     Fscal -= LFC[i] * qq[i] * f_lr;
                     dvdl_coul -= (DLF[i] * qq[i]) * v_lr;
+                    linearCoul[i] -= qq[i] * v_lr;
                 }
             }
 
@@ -765,6 +961,7 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                     vvtot += LFV[i] * c6grid * VV;
                     Fscal += LFV[i] * c6grid * FF;
                     dvdl_vdw += (DLF[i] * c6grid) * VV;
+                    linearVdw[i] += c6grid * VV;
                 }
             }
 
@@ -833,12 +1030,21 @@ static void nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
 #pragma omp atomic
     dvdl[efptVDW] += dvdl_vdw;
 
+    if (doForeignLambdas)
+    {
+        addEnergiesAtLambdas<vdwInteractionTypeIsEwald, elecInteractionTypeIsEwald, vdwModifierIsPotSwitch>(
+                pairPotentialParameters, *ic, softCorePairs, linearCoul, linearVdw, *kernel_data);
+    }
+
     /* Estimate flops, average for free energy stuff:
      * 12  flops per outer iteration
      * 150 flops per inner iteration
+     * 100 flops per soft-core pair per foreign lambda
      */
 #pragma omp atomic
-    inc_nrnb(nrnb, eNR_NBKERNEL_FREE_ENERGY, nlist->nri * 12 + nlist->jindex[nri] * 150);
+    inc_nrnb(nrnb, eNR_NBKERNEL_FREE_ENERGY,
+             nlist->nri * 12 + (nlist->jindex[nri] - nlist->jindex[0]) * 150
+                     + softCorePairs.size() * kernel_data->numForeignLambdas * 100);
 }
 
 typedef void (*KernelFunction)(const t_nblist* gmx_restrict nlist,
@@ -847,6 +1053,7 @@ typedef void (*KernelFunction)(const t_nblist* gmx_restrict nlist,
                                const t_forcerec* gmx_restrict fr,
                                const t_mdatoms* gmx_restrict mdatoms,
                                nb_kernel_data_t* gmx_restrict kernel_data,
+                               SoftCorePairs*                 softCorePairsBuffer,
                                t_nrnb* gmx_restrict nrnb);
 
 template<bool useSoftCore, bool scLambdasOrAlphasDiffer, bool vdwInteractionTypeIsEwald, bool elecInteractionTypeIsEwald, bool vdwModifierIsPotSwitch>
@@ -967,6 +1174,7 @@ void gmx_nb_free_energy_kernel(const t_nblist*            nlist,
                                const t_forcerec*          fr,
                                const t_mdatoms*           mdatoms,
                                nb_kernel_data_t*          kernel_data,
+                               SoftCorePairs*             softCorePairsBuffer,
                                t_nrnb*                    nrnb)
 {
     const interaction_const_t& ic = *fr->ic;
@@ -997,5 +1205,5 @@ void gmx_nb_free_energy_kernel(const t_nblist*            nlist,
     KernelFunction kernelFunc;
     kernelFunc = dispatchKernel(scLambdasOrAlphasDiffer, vdwInteractionTypeIsEwald,
                                 elecInteractionTypeIsEwald, vdwModifierIsPotSwitch, useSimd, ic);
-    kernelFunc(nlist, xx, ff, fr, mdatoms, kernel_data, nrnb);
+    kernelFunc(nlist, xx, ff, fr, mdatoms, kernel_data, softCorePairsBuffer, nrnb);
 }
@@ -38,10 +38,14 @@
 #ifndef _nb_free_energy_h_
 #define _nb_free_energy_h_
 
+#include <array>
+#include <vector>
+
 #include "gromacs/gmxlib/nrnb.h"
 #include "gromacs/gmxlib/nonbonded/nb_kernel.h"
 #include "gromacs/math/vectypes.h"
 #include "gromacs/mdtypes/nblist.h"
+#include "gromacs/utility/real.h"
 
 struct t_forcerec;
 struct t_mdatoms;
@@ -50,12 +54,83 @@ namespace gmx
 class ForceWithShiftForces;
 }
 
+/*! \brief The lambda-independent data of pairs with soft-core interactions
+ *
+ * This is stored as a structure of arrays, so the energies at many lambda
+ * values can be computed with contiguous loops over the pairs after the
+ * pass over the pair list. The kernel clears the buffers on entry, so
+ * keeping one object per thread over the steps avoids reallocation.
+ */
+struct SoftCorePairs
+{
+    //! Adds the data of a pair
+    void add(const real r,
+             const real rp,
+             const real qq[2],
+             const real c6[2],
+             const real c12[2],
+             const real sigma6[2],
+             const real c6grid[2])
+    {
+        this->r.push_back(r);
+        this->rp.push_back(rp);
+        for (int i = 0; i < 2; i++)
+        {
+            this->qq[i].push_back(qq[i]);
+            this->c6[i].push_back(c6[i]);
+            this->c12[i].push_back(c12[i]);
+            this->sigma6[i].push_back(sigma6[i]);
+            this->c6grid[i].push_back(c6grid[i]);
+        }
+    }
+
+    //! Removes all pairs, but keeps the allocated memory
+    void clear()
+    {
+        r.clear();
+        rp.clear();
+        for (int i = 0; i < 2; i++)
+        {
+            qq[i].clear();
+            c6[i].clear();
+            c12[i].clear();
+            sigma6[i].clear();
+            c6grid[i].clear();
+        }
+    }
+
+    //! Returns the number of pairs
+    int size() const { return r.size(); }
+
+    //! The distances
+    std::vector<real> r;
+    //! The distances to the soft-core power
+    std::vector<real> rp;
+    //! The charge products for states A and B
+    std::array<std::vector<real>, 2> qq;
+    //! The dispersion parameters for states A and B
+    std::array<std::vector<real>, 2> c6;
+    //! The repulsion parameters for states A and B
+    std::array<std::vector<real>, 2> c12;
+    //! The soft-core sigma^6 for states A and B
+    std::array<std::vector<real>, 2> sigma6;
+    //! The LJ-PME grid dispersion parameters for states A and B
+    std::array<std::vector<real>, 2> c6grid;
+};
+
+/*! \brief Computes the perturbed non-bonded interactions of \p nlist
+ *
+ * With kernel_data->numForeignLambdas > 0, the soft-core pairs are
+ * stored in \p softCorePairsBuffer, which should not be shared between
+ * concurrent calls.
+ */
 void gmx_nb_free_energy_kernel(const t_nblist* gmx_restrict nlist,
                                rvec* gmx_restrict         xx,
                                gmx::ForceWithShiftForces* forceWithShiftForces,
                                const t_forcerec* gmx_restrict fr,
                                const t_mdatoms* gmx_restrict mdatoms,
                                nb_kernel_data_t* gmx_restrict kernel_data,
+                               SoftCorePairs*                 softCorePairsBuffer,
                                t_nrnb* gmx_restrict nrnb);
 
 #endif
@@ -64,6 +64,16 @@ typedef struct
     /* potentials */
     real* energygrp_elec;
     real* energygrp_vdw;
+
+    /* Energies and dV/dlambda at additional lambda values, computed by the
+     * free-energy kernel in the same pass over the pair list when
+     * numForeignLambdas > 0. The output buffers are added to.
+     */
+    int         numForeignLambdas;
+    const real* foreignLambdaCoul;
+    const real* foreignLambdaVdw;
+    real*       foreignEnergies;
+    real*       foreignDvdl;
 } nb_kernel_data_t;
 
 
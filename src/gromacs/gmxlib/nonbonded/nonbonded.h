@@ -39,7 +39,6 @@
 
 #define GMX_NONBONDED_DO_FORCE (1 << 1)
 #define GMX_NONBONDED_DO_SHIFTFORCE (1 << 2)
-#define GMX_NONBONDED_DO_FOREIGNLAMBDA (1 << 3)
 #define GMX_NONBONDED_DO_POTENTIAL (1 << 4)
 #define GMX_NONBONDED_DO_SR (1 << 5)
 
@@ -0,0 +1,306 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the free-energy non-bonded kernel.
+ *
+ * Checks that the energies and dV/dlambda at the foreign lambda values,
+ * which the kernel computes in the same pass as the forces, match those
+ * of separate kernel calls at each of those lambda values.
+ */
+#include "gmxpre.h"
+
+#include "gromacs/gmxlib/nonbonded/nb_free_energy.h"
+
+#include <cmath>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/gmxlib/nrnb.h"
+#include "gromacs/gmxlib/nonbonded/nb_kernel.h"
+#include "gromacs/gmxlib/nonbonded/nonbonded.h"
+#include "gromacs/math/paddedvector.h"
+#include "gromacs/math/units.h"
+#include "gromacs/math/vectypes.h"
+#include "gromacs/mdtypes/forceoutput.h"
+#include "gromacs/mdtypes/forcerec.h"
+#include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/interaction_const.h"
+#include "gromacs/mdtypes/md_enums.h"
+#include "gromacs/mdtypes/mdatom.h"
+#include "gromacs/mdtypes/nblist.h"
+#include "gromacs/pbcutil/ishift.h"
+#include "gromacs/utility/smalloc.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+namespace test
+{
+namespace
+{
+
+//! Number of atoms in the test system
+constexpr int c_numAtoms = 4;
+//! Number of atom types, the last type has no LJ interactions
+constexpr int c_numTypes = 3;
+
+//! The energies and dV/dlambda at one lambda point
+struct EnergyAndDvdl
+{
+    //! The sum of the Coulomb and VdW energies
+    real energy;
+    //! The sum of the Coulomb and VdW dV/dlambda
+    real dvdl;
+};
+
+/*! \brief Test fixture with a small system with perturbed charges and types
+ *
+ * Atom 0 is decoupled in state B, atom 1 changes its charge and type,
+ * atoms 2 and 3 are not perturbed. The parameter is the soft-core power.
+ */
+class FreeEnergyKernelTest : public ::testing::TestWithParam<int>
+{
+protected:
+    FreeEnergyKernelTest() :
+        x_({ { 1.0, 1.0, 1.0 }, { 1.3, 1.0, 1.0 }, { 1.0, 1.35, 1.1 }, { 1.4, 1.4, 1.2 } }),
+        chargeA_({ 0.4, -0.3, 0.5, -0.5 }),
+        chargeB_({ 0.0, 0.2, 0.5, -0.5 }),
+        typeA_({ 0, 1, 0, 1 }),
+        typeB_({ 2, 0, 0, 1 }),
+        iinr_({ 0, 1 }),
+        jindex_({ 0, 3, 5 }),
+        jjnr_({ 1, 2, 3, 2, 3 }),
+        shift_({ CENTRAL, CENTRAL }),
+        gid_({ 0, 0 })
+    {
+        t_lambda fepvals{};
+        fepvals.sc_alpha     = 0.5;
+        fepvals.sc_power     = GetParam();
+        fepvals.sc_r_power   = 6.0;
+        fepvals.sc_sigma     = 0.3;
+        fepvals.sc_sigma_min = 0.3;
+        fepvals.bScCoul      = TRUE;
+
+        const real rCutoff        = 1.0;
+        ic_.eeltype               = eelRF;
+        ic_.epsfac                = ONE_4PI_EPS0;
+        ic_.rcoulomb              = rCutoff;
+        ic_.k_rf                  = 1 / (2 * rCutoff * rCutoff * rCutoff);
+        ic_.c_rf                  = 1 / rCutoff + ic_.k_rf;
+        ic_.vdwtype               = evdwCUT;
+        ic_.vdw_modifier          = eintmodPOTSHIFT;
+        ic_.rvdw                  = rCutoff;
+        ic_.dispersion_shift.cpot = -1 / std::pow(rCutoff, 6);
+        ic_.repulsion_shift.cpot  = -1 / std::pow(rCutoff, 12);
+        ic_.softCoreParameters = std::make_unique<interaction_const_t::SoftCoreParameters>(fepvals);
+
+        const real c6[c_numTypes]  = { 0.0026, 0.0022, 0 };
+        const real c12[c_numTypes] = { 2.6e-6, 2.0e-6, 0 };
+        fr_.ic                     = &ic_;
+        fr_.ntype                  = c_numTypes;
+        /* The LJ parameters are stored premultiplied by 6 and 12 */
+        fr_.nbfp.resize(2 * c_numTypes * c_numTypes);
+        for (int ti = 0; ti < c_numTypes; ti++)
+        {
+            for (int tj = 0; tj < c_numTypes; tj++)
+            {
+                fr_.nbfp[2 * (ti * c_numTypes + tj)]     = 6 * std::sqrt(c6[ti] * c6[tj]);
+                fr_.nbfp[2 * (ti * c_numTypes + tj) + 1] = 12 * std::sqrt(c12[ti] * c12[tj]);
+            }
+        }
+        snew(fr_.shift_vec, SHIFTS);
+
+        mdatoms_.chargeA = chargeA_.data();
+        mdatoms_.chargeB = chargeB_.data();
+        mdatoms_.typeA   = typeA_.data();
+        mdatoms_.typeB   = typeB_.data();
+
+        nlist_.nri    = iinr_.size();
+        nlist_.nrj    = jjnr_.size();
+        nlist_.iinr   = iinr_.data();
+        nlist_.jindex = jindex_.data();
+        nlist_.jjnr   = jjnr_.data();
+        nlist_.shift  = shift_.data();
+        nlist_.gid    = gid_.data();
+    }
+
+    /*! \brief Runs the kernel at \p lambdaCoul and \p lambdaVdw
+     *
+     * Also computes the energies and dV/dlambda at the foreign lambda values
+     * in \p foreignLambdaCoul and \p foreignLambdaVdw, which are returned.
+     * The energies and dV/dlambda at the current lambda are returned
+     * in \p current.
+     */
+    std::vector<EnergyAndDvdl> runKernel(real                     lambdaCoul,
+                                         real                     lambdaVdw,
+                                         const std::vector<real>& foreignLambdaCoul,
+                                         const std::vector<real>& foreignLambdaVdw,
+                                         EnergyAndDvdl*           current)
+    {
+        PaddedVector<RVec>   force(c_numAtoms, { 0, 0, 0 });
+        std::vector<RVec>    shiftForces(SHIFTS, { 0, 0, 0 });
+        ForceWithShiftForces forceWithShiftForces(force.arrayRefWithPadding(), true, shiftForces);
+
+        real lambda[efptNR] = { 0 };
+        lambda[efptCOUL]    = lambdaCoul;
+        lambda[efptVDW]     = lambdaVdw;
+        real dvdl[efptNR]   = { 0 };
+        real energyElec     = 0;
+        real energyVdw      = 0;
+
+        const int         numForeignLambdas = foreignLambdaCoul.size();
+        std::vector<real> foreignEnergies(numForeignLambdas, 0.0_real);
+        std::vector<real> foreignDvdl(numForeignLambdas, 0.0_real);
+
+        nb_kernel_data_t kernelData{};
+        kernelData.flags = GMX_NONBONDED_DO_FORCE | GMX_NONBONDED_DO_SHIFTFORCE
+                           | GMX_NONBONDED_DO_POTENTIAL | GMX_NONBONDED_DO_SR;
+        kernelData.lambda            = lambda;
+        kernelData.dvdl              = dvdl;
+        kernelData.energygrp_elec    = &energyElec;
+        kernelData.energygrp_vdw     = &energyVdw;
+        kernelData.numForeignLambdas = numForeignLambdas;
+        kernelData.foreignLambdaCoul = foreignLambdaCoul.data();
+        kernelData.foreignLambdaVdw  = foreignLambdaVdw.data();
+        kernelData.foreignEnergies   = foreignEnergies.data();
+        kernelData.foreignDvdl       = foreignDvdl.data();
+
+        t_nrnb nrnb{};
+        gmx_nb_free_energy_kernel(&nlist_, as_rvec_array(x_.data()), &forceWithShiftForces, &fr_,
+                                  &mdatoms_, &kernelData, &softCorePairs_, &nrnb);
+
+        current->energy = energyElec + energyVdw;
+        current->dvdl   = dvdl[efptCOUL] + dvdl[efptVDW];
+
+        std::vector<EnergyAndDvdl> foreign(numForeignLambdas);
+        for (int i = 0; i < numForeignLambdas; i++)
+        {
+            foreign[i] = { foreignEnergies[i], foreignDvdl[i] };
+        }
+        return foreign;
+    }
+
+    /*! \brief Checks the foreign lambda output of a single kernel call
+     *
+     * The reference values are computed with one kernel call per
+     * lambda point without foreign lambdas.
+     */
+    void checkForeignLambdas(real                     lambdaCoul,
+                             real                     lambdaVdw,
+                             const std::vector<real>& foreignLambdaCoul,
+                             const std::vector<real>& foreignLambdaVdw)
+    {
+        EnergyAndDvdl current;
+        const auto    foreign =
+                runKernel(lambdaCoul, lambdaVdw, foreignLambdaCoul, foreignLambdaVdw, &current);
+
+        std::vector<EnergyAndDvdl> reference(foreignLambdaCoul.size());
+        real                       magnitude = 0;
+        for (size_t i = 0; i < foreignLambdaCoul.size(); i++)
+        {
+            runKernel(foreignLambdaCoul[i], foreignLambdaVdw[i], {}, {}, &reference[i]);
+            magnitude = std::max(magnitude, std::abs(reference[i].energy));
+            magnitude = std::max(magnitude, std::abs(reference[i].dvdl));
+        }
+
+        const FloatingPointTolerance tolerance =
+                relativeToleranceAsPrecisionDependentFloatingPoint(magnitude, 1e-5, 1e-10);
+        ASSERT_EQ(reference.size(), foreign.size());
+        for (size_t i = 0; i < reference.size(); i++)
+        {
+            SCOPED_TRACE("At foreign lambda index " + std::to_string(i));
+            EXPECT_REAL_EQ_TOL(reference[i].energy, foreign[i].energy, tolerance);
+            EXPECT_REAL_EQ_TOL(reference[i].dvdl, foreign[i].dvdl, tolerance);
+        }
+    }
+
+    //! The coordinates
+    PaddedVector<RVec> x_;
+    //! The charges in state A
+    std::vector<real> chargeA_;
+    //! The charges in state B
+    std::vector<real> chargeB_;
+    //! The atom types in state A
+    std::vector<int> typeA_;
+    //! The atom types in state B
+    std::vector<int> typeB_;
+    //! The i-atoms of the pair list
+    std::vector<int> iinr_;
+    //! The j-atom ranges of the pair list
+    std::vector<int> jindex_;
+    //! The j-atoms of the pair list
+    std::vector<int> jjnr_;
+    //! The shift indices of the pair list
+    std::vector<int> shift_;
+    //! The energy group indices of the pair list
+    std::vector<int> gid_;
+    //! The interaction constants
+    interaction_const_t ic_;
+    //! The force record, refers to \c ic_
+    t_forcerec fr_;
+    //! The atom data, refers to the charge and type buffers
+    t_mdatoms mdatoms_{};
+    //! The pair list, refers to the pair list buffers
+    t_nblist nlist_{};
+    //! The soft-core pair buffer, reused over all kernel calls
+    SoftCorePairs softCorePairs_;
+};
+
+TEST_P(FreeEnergyKernelTest, ForeignLambdasMatchSingleLambdaCalls)
+{
+    const std::vector<real> foreignLambda = { 0.0, 0.2, 0.5, 0.8, 1.0 };
+
+    checkForeignLambdas(0.5, 0.5, foreignLambda, foreignLambda);
+}
+
+TEST_P(FreeEnergyKernelTest, ForeignLambdasMatchSingleLambdaCallsWithSeparateCoulombAndVdw)
+{
+    const std::vector<real> foreignLambdaCoul = { 0.0, 0.5, 1.0, 1.0, 1.0 };
+    const std::vector<real> foreignLambdaVdw  = { 0.0, 0.0, 0.0, 0.5, 1.0 };
+
+    checkForeignLambdas(1.0, 0.5, foreignLambdaCoul, foreignLambdaVdw);
+}
+
+INSTANTIATE_TEST_CASE_P(WithSoftCorePower, FreeEnergyKernelTest, ::testing::Values(1, 2));
+
+} // namespace
+} // namespace test
+} // namespace gmx
@@ -47,6 +47,7 @@
 
 #include <algorithm>
 #include <numeric>
+#include <set>
 
 #include "gromacs/fileio/confio.h"
 #include "gromacs/gmxpreprocess/gpp_nextnb.h"
@@ -268,6 +269,22 @@ static std::vector<InteractionOfType> clean_dih(gmx::ArrayRef<const InteractionO
             }
         }
     }
+    /* Collect the central bonds of the impropers, so that dihedrals
+     * can be checked against them without a loop over all impropers. */
+    std::set<std::pair<int, int>> improperCentralBonds;
+    if (bRemoveDihedralIfWithImproper)
+    {
+        for (const auto& imp : improper)
+        {
+            improperCentralBonds.emplace(std::min(imp.aj(), imp.ak()),
+                                         std::max(imp.aj(), imp.ak()));
+        }
+    }
+
+    /* Collect the kept dihedrals in a new list, since erasing from
+     * newDihedrals would make this loop quadratic in the number of dihedrals. */
+    std::vector<InteractionOfType> finalDihedrals;
+    finalDihedrals.reserve(newDihedrals.size());
     int k = 0;
     for (auto dihedral = newDihedrals.begin(); dihedral != newDihedrals.end();)
     {
@@ -277,10 +294,9 @@ static std::vector<InteractionOfType> clean_dih(gmx::ArrayRef<const InteractionO
         {
             /* Remove the dihedral if there is an improper on the same
              * bond. */
-            for (auto imp = improper.begin(); imp != improper.end() && bKeep; ++imp)
-            {
-                bKeep = !is_dihedral_on_same_bond(dihedral->first, *imp);
-            }
+            const int aj = dihedral->first.aj();
+            const int ak = dihedral->first.ak();
+            bKeep = (improperCentralBonds.count({ std::min(aj, ak), std::max(aj, ak) }) == 0);
         }
 
         if (bKeep)
@@ -316,21 +332,16 @@ static std::vector<InteractionOfType> clean_dih(gmx::ArrayRef<const InteractionO
             }
             if (k == bestl)
             {
+                finalDihedrals.emplace_back(dihedral->first);
                 ++dihedral;
             }
             k++;
         }
         else
         {
-            dihedral = newDihedrals.erase(dihedral);
+            ++dihedral;
         }
     }
-    std::vector<InteractionOfType> finalDihedrals;
-    finalDihedrals.reserve(newDihedrals.size());
-    for (const auto& param : newDihedrals)
-    {
-        finalDihedrals.emplace_back(param.first);
-    }
     return finalDihedrals;
 }
 
@@ -100,6 +100,69 @@ rand_rot(int natoms, rvec x[], rvec v[], vec4 xrot[], vec4 vrot[], gmx::DefaultR
     }
 }
 
+/*! \brief Copy one conformation into a cell of the grid of boxes.
+ *
+ * The atom and residue information is copied from the first cell,
+ * which holds the original conformation. Different cells can be
+ * filled concurrently, as long as the first cell is not written to.
+ */
+template<typename VectorType>
+static void copyConformationToCell(int               natoms,
+                                   int               nres,
+                                   const VectorType  xSource[],
+                                   const VectorType  vSource[],
+                                   const rvec        shift,
+                                   bool              rotateForScrewPbc,
+                                   const matrix      box,
+                                   bool              bRenum,
+                                   int               ndx,
+                                   int               nrdx,
+                                   rvec              x[],
+                                   rvec              v[],
+                                   t_atoms*          atoms)
+{
+    for (int l = 0; (l < natoms); l++)
+    {
+        for (int m = 0; (m < DIM); m++)
+        {
+            x[ndx + l][m] = xSource[l][m];
+            v[ndx + l][m] = vSource[l][m];
+        }
+        if (rotateForScrewPbc)
+        {
+            /* Rotate around x axis */
+            for (int m = YY; m <= ZZ; m++)
+            {
+                x[ndx + l][m] = box[YY][m] + box[ZZ][m] - x[ndx + l][m];
+                v[ndx + l][m] = -v[ndx + l][m];
+            }
+        }
+        for (int m = 0; (m < DIM); m++)
+        {
+            x[ndx + l][m] += shift[m];
+        }
+        atoms->atom[ndx + l].resind = nrdx + atoms->atom[l].resind;
+        atoms->atomname[ndx + l]    = atoms->atomname[l];
+    }
+
+    for (int l = 0; (l < nres); l++)
+    {
+        atoms->resinfo[nrdx + l] = atoms->resinfo[l];
+        if (bRenum)
+        {
+            atoms->resinfo[nrdx + l].nr += nrdx;
+        }
+    }
+}
+
+//! Returns the shift of the grid cell with indices \p i, \p j and \p k.
+static void gridCellShift(int i, int j, int k, const rvec dist, const matrix box, rvec shift)
+{
+    shift[ZZ] = k * (dist[ZZ] + box[ZZ][ZZ]);
+    shift[YY] = j * (dist[YY] + box[YY][YY]) + k * box[ZZ][YY];
+    shift[XX] = i * (dist[XX] + box[XX][XX]) + j * box[YY][XX] + k * box[ZZ][XX];
+}
+
 int gmx_genconf(int argc, char* argv[])
 {
     const char* desc[] = {
@@ -128,7 +191,7 @@ int gmx_genconf(int argc, char* argv[])
     rvec              shift;
     int               natoms; /* number of atoms in one molecule  */
     int               nres;   /* number of molecules? */
-    int               i, j, k, l, m, ndx, nrdx, nx, ny, nz;
+    int               i, j, k, m, ndx, nrdx, nx, ny, nz;
     t_trxstatus*      status;
     bool              bTRX;
     gmx_output_env_t* oenv;
@@ -206,72 +269,61 @@ int gmx_genconf(int argc, char* argv[])
     }
 
 
-    for (k = 0; (k < nz); k++) /* loop over all gridpositions    */
+    if (!bRandom && !bTRX)
     {
-        shift[ZZ] = k * (dist[ZZ] + box[ZZ][ZZ]);
-
-        for (j = 0; (j < ny); j++)
+        /* All cells get the same conformation, which is already present
+         * in the first cell. The other cells only read from the first cell,
+         * so they can be filled in parallel.
+         */
+#pragma omp parallel for schedule(static) default(none) \
+        shared(natoms, nres, xx, v, dist, box, pbcType, bRenum, x, atoms, ny, nz, vol)
+        for (int cell = 1; cell < vol; cell++)
         {
-            shift[YY] = j * (dist[YY] + box[YY][YY]) + k * box[ZZ][YY];
-
-            for (i = 0; (i < nx); i++)
+            const int i = cell / (ny * nz);
+            const int j = (cell / nz) % ny;
+            const int k = cell % nz;
+            rvec      cellShift;
+            gridCellShift(i, j, k, dist, box, cellShift);
+            copyConformationToCell(natoms, nres, xx, v, cellShift,
+                                   pbcType == PbcType::Screw && i % 2 == 1, box, bRenum,
+                                   cell * natoms, cell * nres, x, v, &atoms);
+        }
+    }
+    else
+    {
+        for (k = 0; (k < nz); k++) /* loop over all gridpositions    */
+        {
+            for (j = 0; (j < ny); j++)
             {
-                shift[XX] = i * (dist[XX] + box[XX][XX]) + j * box[YY][XX] + k * box[ZZ][XX];
-
-                ndx  = (i * ny * nz + j * nz + k) * natoms;
-                nrdx = (i * ny * nz + j * nz + k) * nres;
-
-                /* Random rotation on input coords */
-                if (bRandom)
+                for (i = 0; (i < nx); i++)
                 {
-                    rand_rot(natoms, xx, v, xrot, vrot, &rng, max_rot);
-                }
+                    gridCellShift(i, j, k, dist, box, shift);
 
-                for (l = 0; (l < natoms); l++)
-                {
-                    for (m = 0; (m < DIM); m++)
-                    {
-                        if (bRandom)
-                        {
-                            x[ndx + l][m] = xrot[l][m];
-                            v[ndx + l][m] = vrot[l][m];
-                        }
-                        else
-                        {
-                            x[ndx + l][m] = xx[l][m];
-                            v[ndx + l][m] = v[l][m];
-                        }
-                    }
-                    if (pbcType == PbcType::Screw && i % 2 == 1)
+                    ndx  = (i * ny * nz + j * nz + k) * natoms;
+                    nrdx = (i * ny * nz + j * nz + k) * nres;
+
+                    /* Random rotation on input coords */
+                    if (bRandom)
                     {
-                        /* Rotate around x axis */
-                        for (m = YY; m <= ZZ; m++)
-                        {
-                            x[ndx + l][m] = box[YY][m] + box[ZZ][m] - x[ndx + l][m];
-                            v[ndx + l][m] = -v[ndx + l][m];
-                        }
+                        rand_rot(natoms, xx, v, xrot, vrot, &rng, max_rot);
+                        copyConformationToCell(natoms, nres, xrot, vrot, shift,
+                                               pbcType == PbcType::Screw && i % 2 == 1, box,
+                                               bRenum, ndx, nrdx, x, v, &atoms);
                     }
-                    for (m = 0; (m < DIM); m++)
+                    else
                     {
-                        x[ndx + l][m] += shift[m];
+                        copyConformationToCell(natoms, nres, xx, v, shift,
+                                               pbcType == PbcType::Screw && i % 2 == 1, box,
+                                               bRenum, ndx, nrdx, x, v, &atoms);
                     }
-                    atoms.atom[ndx + l].resind = nrdx + atoms.atom[l].resind;
-                    atoms.atomname[ndx + l]    = atoms.atomname[l];
-                }
 
-                for (l = 0; (l < nres); l++)
-                {
-                    atoms.resinfo[nrdx + l] = atoms.resinfo[l];
-                    if (bRenum)
+                    if (bTRX)
                     {
-                        atoms.resinfo[nrdx + l].nr += nrdx;
-                    }
-                }
-                if (bTRX)
-                {
-                    if (!read_next_x(oenv, status, &t, xx, boxx) && ((i + 1) * (j + 1) * (k + 1) < vol))
-                    {
-                        gmx_fatal(FARGS, "Not enough frames in trajectory");
+                        if (!read_next_x(oenv, status, &t, xx, boxx)
+                            && ((i + 1) * (j + 1) * (k + 1) < vol))
+                        {
+                            gmx_fatal(FARGS, "Not enough frames in trajectory");
+                        }
                     }
                 }
             }
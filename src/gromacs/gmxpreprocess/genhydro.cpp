@@ -41,6 +41,9 @@
 #include <cstring>
 #include <ctime>
 
+#include <string>
+#include <unordered_map>
+
 #include "gromacs/fileio/confio.h"
 #include "gromacs/gmxlib/network.h"
 #include "gromacs/gmxpreprocess/calch.h"
@@ -129,10 +132,18 @@ getMoleculePatchDatabases(const t_atoms*                              pdba,
             mergeAtomAndBondModifications(*ctdb[i], &modBlock[rC[i]]);
         }
     }
-    /* then the whole hdb */
+    /* then the whole hdb, looking up each residue name only once */
+    using HdbIterator = gmx::ArrayRef<const MoleculePatchDatabase>::iterator;
+    std::unordered_map<std::string, HdbIterator> hdbEntryOfResidue;
     for (int rnr = 0; rnr < pdba->nres; rnr++)
     {
-        auto ahptr = search_h_db(globalPatches, *pdba->resinfo[rnr].rtp);
+        const char* rtpName = *pdba->resinfo[rnr].rtp;
+        auto        cached  = hdbEntryOfResidue.find(rtpName);
+        if (cached == hdbEntryOfResidue.end())
+        {
+            cached = hdbEntryOfResidue.emplace(rtpName, search_h_db(globalPatches, rtpName)).first;
+        }
+        auto ahptr = cached->second;
         if (ahptr != globalPatches.end())
         {
             if (modBlock[rnr].name.empty())
@@ -55,6 +55,7 @@
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/random/threefry.h"
 #include "gromacs/random/uniformintdistribution.h"
+#include "gromacs/selection/nbsearch.h"
 #include "gromacs/topology/index.h"
 #include "gromacs/topology/topology.h"
 #include "gromacs/utility/arrayref.h"
@@ -66,37 +67,33 @@
 #include "gromacs/utility/smalloc.h"
 
 
-/*! \brief Return whether any atoms of two groups are below minimum distance.
+/*! \brief Mark solvent molecules that are closer than a minimum distance to given positions.
  *
- * \param[in] pbc the periodic boundary conditions
- * \param[in] x the coordinates
- * \param[in] smallerGroupIndices the atom indices of the first group to check
- * \param[in] largerGroupIndices the atom indices of the second group to check
- * \param[in] minimumDistance the minimum required distance betwenn any atom in
- *                            the first and second group
- * \returns true if any distance between an atom from group A and group B is
- *               smaller than a minimum distance.
+ * \param[in] solventSearch neighborhood search over the solvent atoms
+ * \param[in] positions the positions to check the solvent against
+ * \param[in] numberAtomsPerSolventMolecule how many atoms each solvent molecule contains
+ * \param[in] minimumDistance the minimum required distance between any solvent
+ *                            atom and any of the positions
+ * \param[in,out] isTooClose per solvent molecule, set to true when any of its
+ *                           atoms is below the minimum distance
  */
-static bool groupsCloserThanCutoffWithPbc(t_pbc*                   pbc,
-                                          rvec                     x[],
-                                          gmx::ArrayRef<const int> smallerGroupIndices,
-                                          gmx::ArrayRef<const int> largerGroupIndices,
-                                          real                     minimumDistance)
+static void markSolventMoleculesCloserThanCutoff(gmx::AnalysisNeighborhoodSearch*            solventSearch,
+                                                 const gmx::AnalysisNeighborhoodPositions& positions,
+                                                 int                numberAtomsPerSolventMolecule,
+                                                 real               minimumDistance,
+                                                 std::vector<bool>* isTooClose)
 {
     const real minimumDistance2 = minimumDistance * minimumDistance;
-    for (int aIndex : largerGroupIndices)
+
+    gmx::AnalysisNeighborhoodPairSearch pairSearch = solventSearch->startPairSearch(positions);
+    gmx::AnalysisNeighborhoodPair       pair;
+    while (pairSearch.findNextPair(&pair))
     {
-        for (int bIndex : smallerGroupIndices)
+        if (pair.distance2() < minimumDistance2)
         {
-            rvec dx;
-            pbc_dx(pbc, x[aIndex], x[bIndex], dx);
-            if (norm2(dx) < minimumDistance2)
-            {
-                return true;
-            }
+            (*isTooClose)[pair.refIndex() / numberAtomsPerSolventMolecule] = true;
         }
     }
-    return false;
 }
 
 /*! \brief Calculate the solvent molecule atom indices from molecule number.
@@ -122,32 +119,24 @@ static std::vector<int> solventMoleculeIndices(int solventMoleculeNumber,
     return indices;
 }
 
-static void insert_ion(int                      nsa,
-                       std::vector<int>*        solventMoleculesForReplacement,
-                       int                      repl[],
-                       gmx::ArrayRef<const int> index,
-                       rvec                     x[],
-                       t_pbc*                   pbc,
-                       int                      sign,
-                       int                      q,
-                       const char*              ionname,
-                       t_atoms*                 atoms,
-                       real                     rmin,
-                       std::vector<int>*        notSolventGroup)
+static void insert_ion(int                              nsa,
+                       std::vector<int>*                solventMoleculesForReplacement,
+                       int                              repl[],
+                       gmx::ArrayRef<const int>         index,
+                       rvec                             x[],
+                       int                              sign,
+                       int                              q,
+                       const char*                      ionname,
+                       t_atoms*                         atoms,
+                       gmx::AnalysisNeighborhoodSearch* solventSearch,
+                       real                             rmin,
+                       std::vector<bool>*               isTooClose)
 {
-    std::vector<int> solventMoleculeAtomsToBeReplaced =
-            solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
-
-    if (rmin > 0.0)
+    // Skip solvent molecules that are too close to non-solvent or to ions placed before
+    while (!solventMoleculesForReplacement->empty()
+           && (*isTooClose)[solventMoleculesForReplacement->back()])
     {
-        // check for proximity to non-solvent
-        while (groupsCloserThanCutoffWithPbc(pbc, x, solventMoleculeAtomsToBeReplaced, *notSolventGroup, rmin)
-               && !solventMoleculesForReplacement->empty())
-        {
-            solventMoleculesForReplacement->pop_back();
-            solventMoleculeAtomsToBeReplaced =
-                    solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
-        }
+        solventMoleculesForReplacement->pop_back();
     }
 
     if (solventMoleculesForReplacement->empty())
@@ -155,11 +144,20 @@ static void insert_ion(int                      nsa,
         gmx_fatal(FARGS, "No more replaceable solvent!");
     }
 
+    std::vector<int> solventMoleculeAtomsToBeReplaced =
+            solventMoleculeIndices(solventMoleculesForReplacement->back(), nsa, index);
+
     fprintf(stderr, "Replacing solvent molecule %d (atom %d) with %s\n",
             solventMoleculesForReplacement->back(), solventMoleculeAtomsToBeReplaced[0], ionname);
 
+    /* The ion excludes the solvent around it from further replacement */
+    if (rmin > 0.0)
+    {
+        markSolventMoleculesCloserThanCutoff(solventSearch, x[solventMoleculeAtomsToBeReplaced[0]],
+                                             nsa, rmin, isTooClose);
+    }
+
     /* Replace solvent molecule charges with ion charge */
-    notSolventGroup->push_back(solventMoleculeAtomsToBeReplaced[0]);
     repl[solventMoleculesForReplacement->back()] = sign;
 
     // The first solvent molecule atom is replaced with an ion and the respective
@@ -632,7 +630,23 @@ int gmx_genion(int argc, char* argv[])
         fprintf(stderr, "Using random seed %d.\n", seed);
 
 
-        std::vector<int> notSolventGroup = invertIndexGroup(atoms.nr, solventGroup);
+        // Solvent molecules closer than rmin to non-solvent atoms are never
+        // replaced. Placed ions exclude the solvent around them as we go,
+        // so each check only involves the local neighborhood.
+        std::vector<bool>               isTooClose(nw, false);
+        gmx::AnalysisNeighborhood       nb;
+        gmx::AnalysisNeighborhoodSearch solventSearch;
+        if (rmin > 0.0)
+        {
+            nb.setCutoff(rmin);
+            solventSearch = nb.initSearch(
+                    &pbc, gmx::AnalysisNeighborhoodPositions(x, atoms.nr).indexed(solventGroup));
+            const std::vector<int> notSolventGroup = invertIndexGroup(atoms.nr, solventGroup);
+            markSolventMoleculesCloserThanCutoff(
+                    &solventSearch,
+                    gmx::AnalysisNeighborhoodPositions(x, atoms.nr).indexed(notSolventGroup), nsa,
+                    rmin, &isTooClose);
+        }
 
         std::vector<int> solventMoleculesForReplacement(nw);
         std::iota(std::begin(solventMoleculesForReplacement), std::end(solventMoleculesForReplacement), 0);
@@ -646,13 +660,13 @@ int gmx_genion(int argc, char* argv[])
         /* Now loop over the ions that have to be placed */
         while (p_num-- > 0)
         {
-            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, &pbc, 1, p_q,
-                       p_name, &atoms, rmin, &notSolventGroup);
+            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, 1, p_q, p_name,
+                       &atoms, &solventSearch, rmin, &isTooClose);
         }
         while (n_num-- > 0)
         {
-            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, &pbc, -1, n_q,
-                       n_name, &atoms, rmin, &notSolventGroup);
+            insert_ion(nsa, &solventMoleculesForReplacement, repl, solventGroup, x, -1, n_q, n_name,
+                       &atoms, &solventSearch, rmin, &isTooClose);
         }
         fprintf(stderr, "\n");
 
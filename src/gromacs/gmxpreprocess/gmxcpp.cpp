@@ -48,7 +48,10 @@
 #include <cstring>
 
 #include <algorithm>
+#include <map>
 #include <memory>
+#include <set>
+#include <unordered_map>
 #include <unordered_set>
 
 #include <sys/types.h>
@@ -66,6 +69,21 @@ struct t_define
     std::string def;
 };
 
+/* The defines in order of definition, with a hash map from name to the index
+ * in the list, so that lookups do not need to scan all defines. Names with
+ * non-word characters can not be found by looking up words, so the indices
+ * of those are kept separately. */
+struct t_defines
+{
+    std::vector<t_define>                   list;
+    std::unordered_map<std::string, size_t> index;
+    std::set<size_t>                        nonWordIndices;
+};
+
+/* Cache of resolved include file names, keyed on the working directory
+ * and the name in the #include statement, shared by all files of a run. */
+using t_includeCache = std::map<std::pair<std::string, std::string>, std::string>;
+
 /* enum used for handling ifdefs */
 enum
 {
@@ -77,8 +95,9 @@ enum
 
 struct gmx_cpp
 {
-    std::shared_ptr<std::vector<t_define>>    defines;
+    std::shared_ptr<t_defines>                defines;
     std::shared_ptr<std::vector<std::string>> includes;
+    std::shared_ptr<t_includeCache>           includeCache;
     std::unordered_set<std::string>           unmatched_defines;
     FILE*                                     fp = nullptr;
     std::string                               path;
@@ -170,6 +189,13 @@ static bool find_directive(const char* buf, std::string* name, std::string* val)
     return TRUE;
 }
 
+/* Returns whether a define name consists only of word characters,
+ * so that it can be found by looking up the words of a line. */
+static bool is_word(const std::string& name)
+{
+    return !name.empty() && std::none_of(name.begin(), name.end(), is_word_end);
+}
+
 static bool is_ifdeffed_out(gmx::ArrayRef<const int> ifdefs)
 {
     return (!ifdefs.empty() && ifdefs.back() != eifTRUE);
@@ -191,21 +217,56 @@ static void add_include(std::vector<std::string>* includes, const char* includeP
     includes->push_back(includePath);
 }
 
-static void add_define(std::vector<t_define>* defines, const std::string& name, const char* value)
+static const t_define* find_define(const t_defines& defines, const std::string& name)
+{
+    auto it = defines.index.find(name);
+    return (it != defines.index.end() ? &defines.list[it->second] : nullptr);
+}
+
+static void add_define(t_defines* defines, const std::string& name, const char* value)
 {
     GMX_RELEASE_ASSERT(defines, "Need defines");
     GMX_RELEASE_ASSERT(value, "Need a value");
 
-    for (t_define& define : *defines)
+    auto it = defines->index.find(name);
+    if (it != defines->index.end())
+    {
+        defines->list[it->second].def = value;
+        return;
+    }
+
+    if (!is_word(name))
+    {
+        defines->nonWordIndices.insert(defines->list.size());
+    }
+    defines->index[name] = defines->list.size();
+    defines->list.push_back({ name, value });
+}
+
+static void remove_define(t_defines* defines, const std::string& name)
+{
+    auto it = defines->index.find(name);
+    if (it == defines->index.end())
+    {
+        return;
+    }
+    const size_t removedIndex = it->second;
+    defines->index.erase(it);
+    defines->list.erase(defines->list.begin() + removedIndex);
+    /* Only the defines after the removed one move down */
+    for (size_t i = removedIndex; i < defines->list.size(); i++)
+    {
+        defines->index[defines->list[i].name] = i;
+    }
+    std::set<size_t> nonWordIndices;
+    for (size_t i : defines->nonWordIndices)
     {
-        if (define.name == name)
+        if (i != removedIndex)
         {
-            define.def = value;
-            return;
+            nonWordIndices.insert(i < removedIndex ? i : i - 1);
         }
     }
-
-    defines->push_back({ name, value });
+    defines->nonWordIndices.swap(nonWordIndices);
 }
 
 /* Open the file to be processed. The handle variable holds internal
@@ -213,8 +274,9 @@ static void add_define(std::vector<t_define>* defines, const std::string& name,
 static int cpp_open_file(const char*                                filenm,
                          gmx_cpp_t*                                 handle,
                          char**                                     cppopts,
-                         std::shared_ptr<std::vector<t_define>>*    definesFromParent,
-                         std::shared_ptr<std::vector<std::string>>* includesFromParent)
+                         std::shared_ptr<t_defines>*                definesFromParent,
+                         std::shared_ptr<std::vector<std::string>>* includesFromParent,
+                         std::shared_ptr<t_includeCache>*           includeCacheFromParent)
 {
     // TODO: We should avoid new/delete, we should use Pimpl instead
     gmx_cpp* cpp = new gmx_cpp;
@@ -226,7 +288,7 @@ static int cpp_open_file(const char*                                filenm,
     }
     else
     {
-        cpp->defines = std::make_shared<std::vector<t_define>>();
+        cpp->defines = std::make_shared<t_defines>();
     }
 
     if (includesFromParent)
@@ -238,6 +300,15 @@ static int cpp_open_file(const char*                                filenm,
         cpp->includes = std::make_shared<std::vector<std::string>>();
     }
 
+    if (includeCacheFromParent)
+    {
+        cpp->includeCache = *includeCacheFromParent;
+    }
+    else
+    {
+        cpp->includeCache = std::make_shared<t_includeCache>();
+    }
+
     /* First process options, they might be necessary for opening files
        (especially include statements). */
     int i = 0;
@@ -270,8 +341,20 @@ static int cpp_open_file(const char*                                filenm,
         }
     }
 
+    /* Resolving a file name can require checking many directories,
+     * so we reuse the result when the same file is included again
+     * from the same working directory.
+     */
+    char cwdBuf[STRLEN];
+    gmx_getcwd(cwdBuf, STRLEN);
+    const auto cacheKey    = std::make_pair(std::string(cwdBuf), std::string(filenm));
+    const auto cachedEntry = cpp->includeCache->find(cacheKey);
     /* Find the file. First check whether it is in the current directory. */
-    if (gmx_fexist(filenm))
+    if (cachedEntry != cpp->includeCache->end())
+    {
+        cpp->fn = cachedEntry->second;
+    }
+    else if (gmx_fexist(filenm))
     {
         cpp->fn = filenm;
     }
@@ -297,6 +380,7 @@ static int cpp_open_file(const char*                                filenm,
     {
         gmx_fatal(FARGS, "Topology include file \"%s\" not found", filenm);
     }
+    (*cpp->includeCache)[cacheKey] = cpp->fn;
     /* If the file name has a path component, we need to change to that
      * directory. Note that we - just as C - always use UNIX path separators
      * internally in include file names.
@@ -314,9 +398,7 @@ static int cpp_open_file(const char*                                filenm,
         cpp->path.resize(pos);
         cpp->fn.erase(0, pos + 1);
 
-        char buf[STRLEN];
-        gmx_getcwd(buf, STRLEN);
-        cpp->cwd = buf;
+        cpp->cwd = cwdBuf;
 
         gmx_chdir(cpp->path.c_str());
     }
@@ -344,7 +426,7 @@ static int cpp_open_file(const char*                                filenm,
    info for the cpp emulator. Return integer status */
 int cpp_open_file(const char* filenm, gmx_cpp_t* handle, char** cppopts)
 {
-    return cpp_open_file(filenm, handle, cppopts, nullptr, nullptr);
+    return cpp_open_file(filenm, handle, cppopts, nullptr, nullptr, nullptr);
 }
 
 /* Note that dval might be null, e.g. when handling a line like '#define */
@@ -370,22 +452,16 @@ static int process_directive(gmx_cpp_t* handlep, const std::string& dname, const
             {
                 return eCPP_SYNTAX;
             }
-            bool found = false;
-            for (const t_define& define : *handle->defines)
+            bool found = (find_define(*handle->defines, dval) != nullptr);
+            if (found)
             {
-                if (define.name == dval)
+                // erase from unmatched_defines in original handle
+                gmx_cpp_t root = handle;
+                while (root->parent != nullptr)
                 {
-                    // erase from unmatched_defines in original handle
-                    gmx_cpp_t root = handle;
-                    while (root->parent != nullptr)
-                    {
-                        root = root->parent;
-                    }
-                    root->unmatched_defines.erase(dval);
-
-                    found = true;
-                    break;
+                    root = root->parent;
                 }
+                root->unmatched_defines.erase(dval);
             }
             if ((bIfdef && found) || (bIfndef && !found))
             {
@@ -478,7 +554,7 @@ static int process_directive(gmx_cpp_t* handlep, const std::string& dname, const
 
         /* Open include file and store it as a child in the handle structure */
         int status = cpp_open_file(inc_fn.c_str(), &(handle->child), nullptr, &handle->defines,
-                                   &handle->includes);
+                                   &handle->includes, &handle->includeCache);
         if (status != eCPP_OK)
         {
             handle->child = nullptr;
@@ -523,15 +599,7 @@ static int process_directive(gmx_cpp_t* handlep, const std::string& dname, const
         {
             return eCPP_SYNTAX;
         }
-        std::vector<t_define>& defines = *handle->defines;
-        for (size_t i = 0; i < defines.size(); i++)
-        {
-            if (defines[i].name == dval)
-            {
-                defines.erase(defines.begin() + i);
-                break;
-            }
-        }
+        remove_define(handle->defines.get(), dval);
 
         return eCPP_OK;
     }
@@ -619,12 +687,45 @@ int cpp_read_line(gmx_cpp_t* handlep, int n, char buf[])
         return cpp_read_line(handlep, n, buf);
     }
 
-    /* Check whether we have any defines that need to be replaced. Note
-       that we have to use a best fit algorithm, rather than first come
-       first go. We do this by sorting the defines on length first, and
-       then on alphabetical order. */
-    for (t_define& define : *handle->defines)
-    {
+    /* Check whether we have any defines that need to be replaced.
+       The defines are applied in order of definition, so a define can
+       replace text that was inserted by an earlier define. Instead of
+       scanning the line for every define, we look up the words of the
+       line in the define index, and the words of each inserted value
+       as it gets applied.
+     */
+    const t_defines& defines = *handle->defines;
+    std::set<size_t> pending;
+    auto addDefinesInText    = [&defines, &pending](const char* text, size_t minIndex) {
+        while (*text != '\0')
+        {
+            while (*text != '\0' && is_word_end(*text))
+            {
+                text++;
+            }
+            const char* wordStart = text;
+            while (*text != '\0' && !is_word_end(*text))
+            {
+                text++;
+            }
+            if (text > wordStart)
+            {
+                auto it = defines.index.find(std::string(wordStart, text - wordStart));
+                if (it != defines.index.end() && it->second >= minIndex)
+                {
+                    pending.insert(it->second);
+                }
+            }
+        }
+    };
+    addDefinesInText(buf, 0);
+    /* Names with non-word characters can not be found by word lookup */
+    pending.insert(defines.nonWordIndices.begin(), defines.nonWordIndices.end());
+    while (!pending.empty())
+    {
+        const size_t index = *pending.begin();
+        pending.erase(pending.begin());
+        const t_define& define = defines.list[index];
         if (!define.def.empty())
         {
             int         nn  = 0;
@@ -657,6 +758,8 @@ int cpp_read_line(gmx_cpp_t* handlep, int n, char buf[])
                 GMX_RELEASE_ASSERT(name.size() < static_cast<size_t>(n),
                                    "The line should fit in buf");
                 strcpy(buf, name.c_str());
+
+                addDefinesInText(define.def.c_str(), index + 1);
             }
         }
     }
@@ -703,15 +806,9 @@ int cpp_close_file(gmx_cpp_t* handlep)
 
 const std::string* cpp_find_define(const gmx_cpp_t* handlep, const std::string& defineName)
 {
-    for (const t_define& define : *(*handlep)->defines)
-    {
-        if (define.name == defineName)
-        {
-            return &define.def;
-        }
-    }
+    const t_define* define = find_define(*(*handlep)->defines, defineName);
 
-    return nullptr;
+    return (define != nullptr ? &define->def : nullptr);
 }
 
 void cpp_done(gmx_cpp_t handle)
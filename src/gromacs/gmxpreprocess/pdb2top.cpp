@@ -46,6 +46,7 @@
 
 #include <algorithm>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "gromacs/fileio/pdbio.h"
@@ -982,6 +983,13 @@ void get_hackblocks_rtp(std::vector<MoleculePatchDatabase>*    globalPatches,
     char* key;
     bool  bRM;
 
+    /* Large assemblies contain the same residue types many times, so we
+     * look up each residue name in the database only once. Only exact
+     * matches are cached, so inexact matches still get reported for
+     * every residue.
+     */
+    std::unordered_map<std::string, gmx::index> databaseIndexOfResidue;
+
     globalPatches->resize(nres);
     usedPpResidues->clear();
     /* first the termini */
@@ -1009,8 +1017,23 @@ void get_hackblocks_rtp(std::vector<MoleculePatchDatabase>*    globalPatches,
          */
         key = *resinfo[i].rtp;
 
-        resinfo[i].rtp = put_symtab(symtab, searchResidueDatabase(key, rtpFFDB, logger).c_str());
-        auto res       = getDatabaseEntry(*resinfo[i].rtp, rtpFFDB);
+        gmx::ArrayRef<const PreprocessResidue>::const_iterator res;
+        auto cachedIndex = databaseIndexOfResidue.find(key);
+        if (cachedIndex != databaseIndexOfResidue.end())
+        {
+            res            = rtpFFDB.begin() + cachedIndex->second;
+            resinfo[i].rtp = put_symtab(symtab, res->resname.c_str());
+        }
+        else
+        {
+            resinfo[i].rtp =
+                    put_symtab(symtab, searchResidueDatabase(key, rtpFFDB, logger).c_str());
+            res = getDatabaseEntry(*resinfo[i].rtp, rtpFFDB);
+            if (gmx::equalCaseInsensitive(key, res->resname))
+            {
+                databaseIndexOfResidue[key] = std::distance(rtpFFDB.begin(), res);
+            }
+        }
         usedPpResidues->push_back(PreprocessResidue());
         PreprocessResidue* newentry = &usedPpResidues->back();
         copyPreprocessResidues(*res, newentry, symtab);
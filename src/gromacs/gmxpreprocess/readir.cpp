@@ -57,6 +57,7 @@
 #include "gromacs/math/vec.h"
 #include "gromacs/mdlib/calc_verletbuf.h"
 #include "gromacs/mdrun/mdmodules.h"
+#include "gromacs/mdtypes/awh_params.h"
 #include "gromacs/mdtypes/inputrec.h"
 #include "gromacs/mdtypes/md_enums.h"
 #include "gromacs/mdtypes/multipletimestepping.h"
@@ -313,6 +314,15 @@ static void setupMtsLevels(gmx::ArrayRef<gmx::MtsLevel> mtsLevels,
         {
             checkMtsRequirement(ir, "nstdhdl", ir.fepvals->nstdhdl, wi);
         }
+        if (ir.bPull && mtsLevels[1].forceGroups[static_cast<int>(gmx::MtsForceGroups::Pull)])
+        {
+            checkMtsRequirement(ir, "pull-nstxout", ir.pull->nstxout, wi);
+            checkMtsRequirement(ir, "pull-nstfout", ir.pull->nstfout, wi);
+            if (ir.bDoAwh)
+            {
+                checkMtsRequirement(ir, "awh-nstsample", ir.awhParams->nstSampleCoord, wi);
+            }
+        }
     }
 }
 
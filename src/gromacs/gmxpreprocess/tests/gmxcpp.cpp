@@ -0,0 +1,169 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the topology preprocessor.
+ *
+ * \ingroup module_gmxpreprocess
+ */
+#include "gmxpre.h"
+
+#include "gromacs/gmxpreprocess/gmxcpp.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/utility/cstringutil.h"
+#include "gromacs/utility/path.h"
+#include "gromacs/utility/stringutil.h"
+#include "gromacs/utility/textwriter.h"
+
+#include "testutils/testfilemanager.h"
+
+namespace gmx
+{
+namespace
+{
+
+class GmxCppTest : public ::testing::Test
+{
+public:
+    //! Returns all lines produced by preprocessing \p fileName.
+    std::vector<std::string> preprocess(const std::string& fileName)
+    {
+        gmx_cpp_t handle;
+        EXPECT_EQ(eCPP_OK, cpp_open_file(fileName.c_str(), &handle, nullptr));
+        std::vector<std::string> lines;
+        char                     buf[STRLEN];
+        int                      status;
+        while ((status = cpp_read_line(&handle, STRLEN, buf)) == eCPP_OK)
+        {
+            lines.emplace_back(stripString(buf));
+        }
+        EXPECT_EQ(eCPP_EOF, status);
+        cpp_done(handle);
+        return lines;
+    }
+
+protected:
+    test::TestFileManager fileManager_;
+};
+
+TEST_F(GmxCppTest, ReplacesDefinesOnWordBoundaries)
+{
+    const std::string fileName = fileManager_.getTemporaryFilePath("top");
+    TextWriter::writeFileFromString(fileName,
+                                    "#define gb_1 0.1 1000\n"
+                                    "#define gb_12 0.2 2000\n"
+                                    "1 2 2 gb_1\n"
+                                    "1 3 2 gb_12\n"
+                                    "1 4 2 xgb_1\n");
+    std::vector<std::string> lines = preprocess(fileName);
+    ASSERT_EQ(3, lines.size());
+    EXPECT_EQ("1 2 2 0.1 1000", lines[0]);
+    EXPECT_EQ("1 3 2 0.2 2000", lines[1]);
+    EXPECT_EQ("1 4 2 xgb_1", lines[2]);
+}
+
+TEST_F(GmxCppTest, AppliesDefinesInOrderOfDefinition)
+{
+    const std::string fileName = fileManager_.getTemporaryFilePath("top");
+    TextWriter::writeFileFromString(fileName,
+                                    "#define EARLY early\n"
+                                    "#define OUTER INNER EARLY\n"
+                                    "#define INNER inner\n"
+                                    "OUTER\n");
+    std::vector<std::string> lines = preprocess(fileName);
+    ASSERT_EQ(1, lines.size());
+    // INNER is defined after OUTER, so it is replaced in the expansion
+    // of OUTER, while EARLY is defined before OUTER and is not.
+    EXPECT_EQ("inner EARLY", lines[0]);
+}
+
+TEST_F(GmxCppTest, HandlesIfdefAndUndef)
+{
+    const std::string fileName = fileManager_.getTemporaryFilePath("top");
+    TextWriter::writeFileFromString(fileName,
+                                    "#define FLEXIBLE\n"
+                                    "#ifdef FLEXIBLE\n"
+                                    "flexible\n"
+                                    "#else\n"
+                                    "rigid\n"
+                                    "#endif\n"
+                                    "#undef FLEXIBLE\n"
+                                    "#ifndef FLEXIBLE\n"
+                                    "undefined\n"
+                                    "#endif\n");
+    std::vector<std::string> lines = preprocess(fileName);
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ("flexible", lines[0]);
+    EXPECT_EQ("undefined", lines[1]);
+}
+
+TEST_F(GmxCppTest, KeepsDefineOrderAndNonWordNamesAfterUndef)
+{
+    const std::string fileName = fileManager_.getTemporaryFilePath("top");
+    TextWriter::writeFileFromString(fileName,
+                                    "#define REMOVED removed\n"
+                                    "#define B-C bc\n"
+                                    "#define OUTER INNER\n"
+                                    "#undef REMOVED\n"
+                                    "#define INNER inner\n"
+                                    "#define X.Y xy\n"
+                                    "OUTER B-C X.Y REMOVED\n");
+    std::vector<std::string> lines = preprocess(fileName);
+    ASSERT_EQ(1, lines.size());
+    EXPECT_EQ("inner bc xy REMOVED", lines[0]);
+}
+
+TEST_F(GmxCppTest, IncludesFileRepeatedly)
+{
+    const std::string includeName = fileManager_.getTemporaryFilePath("itp");
+    const std::string fileName    = fileManager_.getTemporaryFilePath("top");
+    TextWriter::writeFileFromString(includeName, "VALUE\n");
+    const std::string include = "#include \"" + Path::getFilename(includeName) + "\"\n";
+    TextWriter::writeFileFromString(fileName,
+                                    "#define VALUE first\n" + include + "#undef VALUE\n"
+                                            + "#define VALUE second\n" + include);
+    std::vector<std::string> lines = preprocess(fileName);
+    ASSERT_EQ(2, lines.size());
+    EXPECT_EQ("first", lines[0]);
+    EXPECT_EQ("second", lines[1]);
+}
+
+} // namespace
+} // namespace gmx
@@ -180,6 +180,19 @@ INSTANTIATE_TEST_CASE_P(ForGromos53a6,
                                                              "fragment3.pdb",
                                                              "fragment4.pdb"),
                                            ::testing::Values(efGRO)));
+
+// Two identical chains repeat each residue type, and with gromos43a1
+// generated dihedrals on the central bonds of impropers are removed.
+// The chains are merged so the whole topology is in topol.top.
+INSTANTIATE_TEST_CASE_P(RepeatedChains,
+                        Pdb2gmxTest,
+                        ::testing::Combine(::testing::Values("gromos43a1"),
+                                           ::testing::Values("spc"),
+                                           ::testing::Values("none"),
+                                           ::testing::Values("id"),
+                                           ::testing::Values("all"),
+                                           ::testing::Values("repeated-chains.pdb"),
+                                           ::testing::Values(efGRO)));
 #endif
 
 #if AMBER
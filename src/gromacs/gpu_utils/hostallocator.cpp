@@ -63,7 +63,7 @@ HostAllocationPolicy::HostAllocationPolicy(PinningPolicy pinningPolicy) :
 std::size_t HostAllocationPolicy::alignment() const noexcept
 {
     return (pinningPolicy_ == PinningPolicy::PinnedIfSupported ? PageAlignedAllocationPolicy::alignment()
-                                                               : AlignedAllocationPolicy::alignment());
+                                                               : NumaAwareAllocationPolicy::alignment());
 }
 
 void* HostAllocationPolicy::malloc(std::size_t bytes) const noexcept
@@ -91,7 +91,7 @@ void* HostAllocationPolicy::malloc(std::size_t bytes) const noexcept
     }
     else
     {
-        return AlignedAllocationPolicy::malloc(bytes);
+        return NumaAwareAllocationPolicy::malloc(bytes);
     }
 }
 
@@ -109,7 +109,7 @@ void HostAllocationPolicy::free(void* buffer) const noexcept
     }
     else
     {
-        AlignedAllocationPolicy::free(buffer);
+        NumaAwareAllocationPolicy::free(buffer);
     }
 }
 
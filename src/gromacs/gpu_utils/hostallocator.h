@@ -113,9 +113,11 @@ using PaddedHostVector = PaddedVector<T, HostAllocator<T>>;
  * page pinned to physical memory if the pinning mode has been
  * activated. If pinning mode is deactivated, or the GROMACS build
  * does not support CUDA, then the memory will be allocated with
- * AlignedAllocator. The pin() and unpin() methods work with the CUDA
- * build, and silently do nothing otherwise. In future, we may modify
- * or generalize this to work differently in other cases.
+ * NumaAwareAllocator, which places the pages of large buffers on the
+ * NUMA nodes of the OpenMP threads that use them. The pin() and
+ * unpin() methods work with the CUDA build, and silently do nothing
+ * otherwise. In future, we may modify or generalize this to work
+ * differently in other cases.
  *
  * The intended use is to configure gmx::Allocator with this class as
  * its policy class, and then to use e.g.
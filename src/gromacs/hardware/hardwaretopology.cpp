@@ -749,6 +749,13 @@ HardwareTopology::HardwareTopology(int logicalProcessorCount) :
     }
 }
 
+HardwareTopology::HardwareTopology(const Machine& machine, SupportLevel supportLevel) :
+    supportLevel_(supportLevel),
+    machine_(machine),
+    isThisSystem_(false)
+{
+}
+
 int HardwareTopology::numberOfCores() const
 {
     if (supportLevel() >= SupportLevel::Basic)
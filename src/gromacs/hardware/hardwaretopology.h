@@ -198,6 +198,12 @@ public:
      */
     explicit HardwareTopology(int logicalProcessorCount);
 
+    /*! \brief Creates a topology from a given machine description.
+     *
+     * Intended for testing of code that uses the hardware topology.
+     */
+    HardwareTopology(const Machine& machine, SupportLevel supportLevel);
+
     /*! \brief Check what topology information that is available and valid
      *
      *  The amount of hardware topology information that can be detected depends
@@ -188,6 +188,28 @@ void gmx_sparsematrix_increment_value(gmx_sparsematrix_t* A, int row, int col, r
 }
 
 
+void gmx_sparsematrix_set_row(gmx_sparsematrix_t* A, int row, int ncol, const int* col,
+                              const real* value)
+{
+    int i;
+
+    assert(row < A->nrow);
+    assert(A->ndata[row] == 0);
+
+    if (ncol > A->nalloc[row])
+    {
+        A->nalloc[row] = ncol;
+        srenew(A->data[row], A->nalloc[row]);
+    }
+    for (i = 0; i < ncol; i++)
+    {
+        A->data[row][i].col   = col[i];
+        A->data[row][i].value = value[i];
+    }
+    A->ndata[row] = ncol;
+}
+
+
 /* Routine to compare column values of two entries, used for quicksort of each row.
  *
  * The data entries to compare are of the type gmx_sparsematrix_entry_t, but quicksort
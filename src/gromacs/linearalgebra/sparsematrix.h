@@ -153,6 +153,17 @@ real gmx_sparsematrix_value(gmx_sparsematrix_t* A, int row, int col);
 void gmx_sparsematrix_increment_value(gmx_sparsematrix_t* A, int row, int col, real difference);
 
 
+/*! \brief Set all entries of a row that does not have any entries yet
+ *
+ * This is much faster than calling gmx_sparsematrix_increment_value()
+ * for each entry when a complete row is known at once, since no search
+ * for existing entries is needed. The columns should be passed in
+ * ascending order to keep the row sorted.
+ */
+void gmx_sparsematrix_set_row(gmx_sparsematrix_t* A, int row, int ncol, const int* col,
+                              const real* value);
+
+
 /*! \brief Sort elements in each column and remove zeros.
  *
  *  Sparse matrix access is faster when the elements are stored in
@@ -4003,6 +4003,136 @@ real calculateSimpleBond(const int           ftype,
     return v;
 }
 
+bool simpleBondSupportsMultipleLambdas(const int ftype)
+{
+    switch (ftype)
+    {
+        case F_BONDS:
+        case F_HARMONIC:
+        case F_ANGLES:
+        case F_PDIHS:
+        case F_PIDIHS:
+        case F_IDIHS: return true;
+        default: return false;
+    }
+}
+
+void calculateSimpleBondEnergiesAtLambdas(const int                 ftype,
+                                          const int                 numForceatoms,
+                                          const t_iatom             forceatoms[],
+                                          const t_iparams           forceparams[],
+                                          const rvec                x[],
+                                          const struct t_pbc*       pbc,
+                                          gmx::ArrayRef<const real> lambdas,
+                                          gmx::ArrayRef<real>       energies,
+                                          gmx::ArrayRef<real>       dvdlambda)
+{
+    GMX_ASSERT(energies.size() == lambdas.size() && dvdlambda.size() == lambdas.size(),
+               "We need an energy and dV/dlambda entry for each lambda value");
+
+    const int numLambdas = lambdas.ssize();
+    const int nfa1       = 1 + interaction_function[ftype].nratoms;
+
+    int  t1, t2, t3;
+    rvec r_ij, r_kj, r_kl, m, n;
+    for (int i = 0; i < numForceatoms;)
+    {
+        const t_iparams& params = forceparams[forceatoms[i]];
+        const int        ai     = forceatoms[i + 1];
+        const int        aj     = forceatoms[i + 2];
+        switch (ftype)
+        {
+            case F_BONDS:
+            case F_HARMONIC:
+            {
+                pbc_rvec_sub(pbc, x[ai], x[aj], r_ij);
+                const real dr2 = iprod(r_ij, r_ij);
+                const real dr  = std::sqrt(dr2);
+                for (int l = 0; l < numLambdas; l++)
+                {
+                    real v, f;
+                    dvdlambda[l] += harmonic(params.harmonic.krA, params.harmonic.krB,
+                                             params.harmonic.rA, params.harmonic.rB, dr, lambdas[l],
+                                             &v, &f);
+                    /* As bonds(), skip the energy of bonds with zero length */
+                    if (dr2 != 0)
+                    {
+                        energies[l] += v;
+                    }
+                }
+                i += nfa1;
+                break;
+            }
+            case F_ANGLES:
+            {
+                real       cosTheta;
+                const real theta = bond_angle(x[ai], x[aj], x[forceatoms[i + 3]], pbc, r_ij, r_kj,
+                                              &cosTheta, &t1, &t2);
+                for (int l = 0; l < numLambdas; l++)
+                {
+                    real v, dVdt;
+                    dvdlambda[l] += harmonic(
+                            params.harmonic.krA, params.harmonic.krB, params.harmonic.rA * DEG2RAD,
+                            params.harmonic.rB * DEG2RAD, theta, lambdas[l], &v, &dVdt);
+                    energies[l] += v;
+                }
+                i += nfa1;
+                break;
+            }
+            case F_PDIHS:
+            case F_PIDIHS:
+            {
+                const int  ak  = forceatoms[i + 3];
+                const int  al  = forceatoms[i + 4];
+                const real phi = dih_angle(x[ai], x[aj], x[ak], x[al], pbc, r_ij, r_kj, r_kl, m, n,
+                                           &t1, &t2, &t3);
+                /* As in pdihs(), loop over dihedrals working on the same atoms */
+                do
+                {
+                    const t_iparams& dihParams = forceparams[forceatoms[i]];
+                    for (int l = 0; l < numLambdas; l++)
+                    {
+                        dopdihs<BondedKernelFlavor::ForcesAndEnergy>(
+                                dihParams.pdihs.cpA, dihParams.pdihs.cpB, dihParams.pdihs.phiA,
+                                dihParams.pdihs.phiB, dihParams.pdihs.mult, phi, lambdas[l],
+                                &energies[l], &dvdlambda[l]);
+                    }
+                    i += nfa1;
+                } while (i < numForceatoms && forceatoms[i + 1] == ai && forceatoms[i + 2] == aj
+                         && forceatoms[i + 3] == ak && forceatoms[i + 4] == al);
+                break;
+            }
+            case F_IDIHS:
+            {
+                const real phi = dih_angle(x[ai], x[aj], x[forceatoms[i + 3]], x[forceatoms[i + 4]],
+                                           pbc, r_ij, r_kj, r_kl, m, n, &t1, &t2, &t3);
+                const real kA  = params.harmonic.krA;
+                const real kB  = params.harmonic.krB;
+                const real pA  = params.harmonic.rA;
+                const real pB  = params.harmonic.rB;
+                for (int l = 0; l < numLambdas; l++)
+                {
+                    const real lambda = lambdas[l];
+                    const real L1     = 1 - lambda;
+                    const real kk     = L1 * kA + lambda * kB;
+                    const real phi0   = (L1 * pA + lambda * pB) * DEG2RAD;
+                    const real dphi0  = (pB - pA) * DEG2RAD;
+
+                    real dp = phi - phi0;
+                    make_dp_periodic(&dp);
+                    const real dp2 = dp * dp;
+
+                    energies[l] += 0.5 * kk * dp2;
+                    dvdlambda[l] += 0.5 * (kB - kA) * dp2 - kk * dphi0 * dp;
+                }
+                i += nfa1;
+                break;
+            }
+            default: gmx_incons("Unsupported interaction type for multiple lambda values");
+        }
+    }
+}
+
 int nrnbIndex(int ftype)
 {
     return c_bondedInteractionFunctions<BondedKernelFlavor::ForcesAndVirialAndEnergy>[ftype].nrnbIndex;
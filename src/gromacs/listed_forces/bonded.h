@@ -50,6 +50,7 @@
 
 #include "gromacs/math/vectypes.h"
 #include "gromacs/topology/ifunc.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/basedefinitions.h"
 
 struct gmx_cmap_t;
@@ -172,6 +173,28 @@ real calculateSimpleBond(int                 ftype,
                          int gmx_unused*    global_atom_index,
                          BondedKernelFlavor bondedKernelFlavor);
 
+/*! \brief Returns whether calculateSimpleBondEnergiesAtLambdas() supports \p ftype */
+bool simpleBondSupportsMultipleLambdas(int ftype);
+
+/*! \brief Calculates the energies of simple bonded interactions at multiple lambda values
+ *
+ * The geometry of each interaction is computed once and the energy
+ * is evaluated for all lambda values. Forces are not computed.
+ * The energy and dV/dlambda at \p lambdas[i] are added to \p energies[i]
+ * and \p dvdlambda[i], respectively.
+ * Exits with an error when \p ftype is not supported,
+ * see simpleBondSupportsMultipleLambdas().
+ */
+void calculateSimpleBondEnergiesAtLambdas(int                       ftype,
+                                          int                       numForceatoms,
+                                          const t_iatom             forceatoms[],
+                                          const t_iparams           forceparams[],
+                                          const rvec                x[],
+                                          const struct t_pbc*       pbc,
+                                          gmx::ArrayRef<const real> lambdas,
+                                          gmx::ArrayRef<real>       energies,
+                                          gmx::ArrayRef<real>       dvdlambda);
+
 //! Getter for finding the flop count for an \c ftype interaction.
 int nrnbIndex(int ftype);
 
@@ -60,6 +60,7 @@
 #include "gromacs/listed_forces/pairs.h"
 #include "gromacs/listed_forces/position_restraints.h"
 #include "gromacs/math/vec.h"
+#include "gromacs/mdlib/accumulation.h"
 #include "gromacs/mdlib/enerdata_utils.h"
 #include "gromacs/mdlib/force.h"
 #include "gromacs/mdlib/gmx_omp_nthreads.h"
@@ -272,10 +273,17 @@ void reduce_thread_forces(gmx::ArrayRef<gmx::RVec> force, const bonded_threading
                 a1 = std::min(a1, numAtomsForce);
                 for (int a = a0; a < a1; a++)
                 {
+                    /* Sum all contributions before rounding to the force buffer */
+                    accum_real fSum[DIM] = { f[a][XX], f[a][YY], f[a][ZZ] };
                     for (int fb = 0; fb < nfb; fb++)
                     {
-                        rvec_inc(f[a], fp[fb][a]);
+                        fSum[XX] += fp[fb][a][XX];
+                        fSum[YY] += fp[fb][a][YY];
+                        fSum[ZZ] += fp[fb][a][ZZ];
                     }
+                    f[a][XX] = fSum[XX];
+                    f[a][YY] = fSum[YY];
+                    f[a][ZZ] = fSum[ZZ];
                 }
             }
         }
@@ -618,6 +626,7 @@ void calc_listed(struct gmx_wallcycle*         wcycle,
 /*! \brief As calc_listed(), but only determines the potential energy
  * for the perturbed interactions.
  *
+ * Interaction types that calcListedEnergiesAtLambdas() handles are skipped.
  * The shift forces in fr are not affected.
  */
 void calc_listed_lambda(const InteractionDefinitions& idef,
@@ -658,7 +667,7 @@ void calc_listed_lambda(const InteractionDefinitions& idef,
     /* Loop over all bonded force types to calculate the bonded energies */
     for (int ftype = 0; (ftype < F_NRE); ftype++)
     {
-        if (ftype_is_bonded_potential(ftype))
+        if (ftype_is_bonded_potential(ftype) && !simpleBondSupportsMultipleLambdas(ftype))
         {
             const InteractionList& ilist = idef.il[ftype];
             /* Create a temporary iatom list with only perturbed interactions */
@@ -682,6 +691,57 @@ void calc_listed_lambda(const InteractionDefinitions& idef,
     }
 }
 
+//! Returns whether there are perturbed interactions that calc_listed_lambda() needs to compute
+bool haveSingleLambdaPerturbedInteractions(const InteractionDefinitions& idef)
+{
+    for (int ftype = 0; ftype < F_NRE; ftype++)
+    {
+        if (ftype_is_bonded_potential(ftype) && !simpleBondSupportsMultipleLambdas(ftype)
+            && idef.numNonperturbedInteractions[ftype] < idef.il[ftype].size())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+/*! \brief Determines the potential energy of the perturbed interactions
+ * at all \p lambdas in a single pass, for the types that support this
+ *
+ * The energy and dV/dlambda at \p lambdas[i] are added to \p energies[i]
+ * and \p dvdl[i], respectively.
+ */
+void calcListedEnergiesAtLambdas(const InteractionDefinitions& idef,
+                                 const rvec                    x[],
+                                 const t_forcerec*             fr,
+                                 const struct t_pbc*           pbc,
+                                 ArrayRef<const real>          lambdas,
+                                 ArrayRef<real>                energies,
+                                 ArrayRef<real>                dvdl,
+                                 t_nrnb*                       nrnb)
+{
+    const t_pbc* pbc_null = fr->bMolPBC ? pbc : nullptr;
+
+    for (int ftype = 0; ftype < F_NRE; ftype++)
+    {
+        if (simpleBondSupportsMultipleLambdas(ftype))
+        {
+            const InteractionList& ilist           = idef.il[ftype];
+            const int              numNonperturbed = idef.numNonperturbedInteractions[ftype];
+            const int              numPerturbed    = ilist.size() - numNonperturbed;
+            if (numPerturbed > 0)
+            {
+                calculateSimpleBondEnergiesAtLambdas(ftype, numPerturbed,
+                                                     ilist.iatoms.data() + numNonperturbed,
+                                                     idef.iparams.data(), x, pbc_null, lambdas,
+                                                     energies, dvdl);
+                inc_nrnb(nrnb, nrnbIndex(ftype),
+                         numPerturbed / (1 + interaction_function[ftype].nratoms));
+            }
+        }
+    }
+}
+
 } // namespace
 
 void ListedForces::calculate(struct gmx_wallcycle*                     wcycle,
@@ -776,22 +836,46 @@ void ListedForces::calculate(struct gmx_wallcycle*                     wcycle,
             {
                 gmx_incons("The bonded interactions are not sorted for free energy");
             }
-            for (int i = 0; i < 1 + enerd->foreignLambdaTerms.numLambdas(); i++)
+            const int numLambdas = 1 + enerd->foreignLambdaTerms.numLambdas();
+
+            /* Most perturbed interaction types are computed for all lambda values
+             * at once, so their geometry is only determined once.
+             */
+            std::vector<real> lambdasBonded(numLambdas);
+            std::vector<real> energiesBonded(numLambdas, 0.0_real);
+            std::vector<real> dvdlBonded(numLambdas, 0.0_real);
+            for (int i = 0; i < numLambdas; i++)
             {
-                real lam_i[efptNR];
+                lambdasBonded[i] =
+                        (i == 0 ? lambda[efptBONDED] : fepvals->all_lambda[efptBONDED][i - 1]);
+            }
+            calcListedEnergiesAtLambdas(idef, x, fr, pbc, lambdasBonded, energiesBonded,
+                                        dvdlBonded, nrnb);
 
-                reset_foreign_enerdata(enerd);
-                for (int j = 0; j < efptNR; j++)
+            const bool computeSingleLambda = haveSingleLambdaPerturbedInteractions(idef);
+            for (int i = 0; i < numLambdas; i++)
+            {
+                double energy  = energiesBonded[i];
+                double dvdlSum = dvdlBonded[i];
+                if (computeSingleLambda)
                 {
-                    lam_i[j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
+                    real lam_i[efptNR];
+
+                    reset_foreign_enerdata(enerd);
+                    for (int j = 0; j < efptNR; j++)
+                    {
+                        lam_i[j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
+                    }
+                    calc_listed_lambda(idef, threading_.get(), x, fr, pbc, forceBufferLambda_,
+                                       shiftForceBufferLambda_, &(enerd->foreign_grpp),
+                                       enerd->foreign_term, dvdl, nrnb, lam_i, md, fcdata,
+                                       global_atom_index);
+                    sum_epot(enerd->foreign_grpp, enerd->foreign_term);
+                    energy += enerd->foreign_term[F_EPOT];
+                    dvdlSum += std::accumulate(std::begin(dvdl), std::end(dvdl), 0.);
+                    std::fill(std::begin(dvdl), std::end(dvdl), 0.0);
                 }
-                calc_listed_lambda(idef, threading_.get(), x, fr, pbc, forceBufferLambda_,
-                                   shiftForceBufferLambda_, &(enerd->foreign_grpp), enerd->foreign_term,
-                                   dvdl, nrnb, lam_i, md, fcdata, global_atom_index);
-                sum_epot(enerd->foreign_grpp, enerd->foreign_term);
-                const double dvdlSum = std::accumulate(std::begin(dvdl), std::end(dvdl), 0.);
-                std::fill(std::begin(dvdl), std::end(dvdl), 0.0);
-                enerd->foreignLambdaTerms.accumulate(i, enerd->foreign_term[F_EPOT], dvdlSum);
+                enerd->foreignLambdaTerms.accumulate(i, energy, dvdlSum);
             }
             wallcycle_sub_stop(wcycle, ewcsLISTED_FEP);
         }
@@ -579,6 +579,30 @@ protected:
             checkOutput(checker, output, flavor);
         }
     }
+    //! Checks that the energies computed for multiple lambda values at once match single lambda values
+    void testMultipleLambdas(const std::vector<t_iatom>& iatoms, ArrayRef<const real> lambdas)
+    {
+        std::vector<real> energies(lambdas.size(), 0.0_real);
+        std::vector<real> dvdlambdas(lambdas.size(), 0.0_real);
+        calculateSimpleBondEnergiesAtLambdas(input_.ftype, iatoms.size(), iatoms.data(),
+                                             &input_.iparams, as_rvec_array(x_.data()), &pbc_,
+                                             lambdas, energies, dvdlambdas);
+        std::vector<int> ddgatindex = { 0, 1, 2, 3 };
+        t_mdatoms        mdatoms    = { 0 };
+        for (gmx::index l = 0; l < lambdas.ssize(); l++)
+        {
+            OutputQuantities output;
+            output.energy = calculateSimpleBond(
+                    input_.ftype, iatoms.size(), iatoms.data(), &input_.iparams,
+                    as_rvec_array(x_.data()), output.f, output.fshift, &pbc_, lambdas[l],
+                    &output.dvdlambda, &mdatoms, nullptr, ddgatindex.data(),
+                    BondedKernelFlavor::ForcesAndVirialAndEnergy);
+            EXPECT_REAL_EQ_TOL(output.energy, energies[l],
+                               test::relativeToleranceAsFloatingPoint(output.energy, 1e-6));
+            EXPECT_REAL_EQ_TOL(output.dvdlambda, dvdlambdas[l],
+                               test::relativeToleranceAsFloatingPoint(output.dvdlambda, 1e-6));
+        }
+    }
     void testIfunc()
     {
         test::TestReferenceChecker thisChecker =
@@ -588,12 +612,18 @@ protected:
         fillIatoms(input_.ftype, &iatoms);
         if (input_.fep)
         {
-            const int numLambdas = 3;
+            const int         numLambdas = 3;
+            std::vector<real> lambdas;
             for (int i = 0; i < numLambdas; ++i)
             {
                 const real lambda       = i / (numLambdas - 1.0);
                 auto       valueChecker = thisChecker.checkCompound("Lambda", toString(lambda));
                 testOneIfunc(&valueChecker, iatoms, lambda);
+                lambdas.push_back(lambda);
+            }
+            if (simpleBondSupportsMultipleLambdas(input_.ftype))
+            {
+                testMultipleLambdas(iatoms, lambdas);
             }
         }
         else
@@ -40,6 +40,8 @@
 
 #include "broadcaststructs.h"
 
+#include "config.h"
+
 #include "gromacs/fileio/tpxio.h"
 #include "gromacs/mdtypes/state.h"
 
@@ -118,16 +120,33 @@ static void bc_tprCharBuffer(MPI_Comm communicator, bool isMasterRank, std::vect
     nblock_abc(isMasterRank, communicator, elements, charBuffer);
 }
 
-void init_parallel(MPI_Comm                    communicator,
-                   bool                        isMasterRank,
-                   t_inputrec*                 inputrec,
-                   gmx_mtop_t*                 mtop,
-                   PartialDeserializedTprFile* partialDeserializedTpr)
+void init_parallel(MPI_Comm                     communicator,
+                   bool                         isMasterRank,
+                   t_inputrec*                  inputrec,
+                   std::shared_ptr<gmx_mtop_t>* globalTopology,
+                   PartialDeserializedTprFile*  partialDeserializedTpr)
 {
     bc_tpxheader(communicator, &partialDeserializedTpr->header);
     bc_tprCharBuffer(communicator, isMasterRank, &partialDeserializedTpr->body);
+#if GMX_THREAD_MPI
+    /* All thread-MPI ranks live in the same address space, so the ranks
+     * take a reference to the topology of the master rank instead of
+     * each deserializing their own copy. Only the inputrec, which ranks
+     * modify, is deserialized on every rank.
+     */
+    std::shared_ptr<gmx_mtop_t>* masterGlobalTopology = globalTopology;
+    block_bc(communicator, masterGlobalTopology);
+    if (!isMasterRank)
+    {
+        *globalTopology = *masterGlobalTopology;
+        completeTprDeserialization(partialDeserializedTpr, inputrec, nullptr);
+    }
+    // The master handle should not go out of scope before all ranks copied it
+    gmx_barrier(communicator);
+#else
     if (!isMasterRank)
     {
-        completeTprDeserialization(partialDeserializedTpr, inputrec, mtop);
+        completeTprDeserialization(partialDeserializedTpr, inputrec, globalTopology->get());
     }
+#endif
 }
@@ -45,6 +45,7 @@
 #ifndef GMX_MDLIB_BROADCASTSTRUCTS_H
 #define GMX_MDLIB_BROADCASTSTRUCTS_H
 
+#include <memory>
 #include <vector>
 
 #include "gromacs/gmxlib/network.h"
@@ -116,11 +117,16 @@ void broadcastStateWithoutDynamics(MPI_Comm communicator,
                                    bool     isParallelRun,
                                    t_state* state);
 
-//! \brief Broadcast inputrec and mtop and allocate node-specific settings
-void init_parallel(MPI_Comm                    communicator,
-                   bool                        isMasterRank,
-                   t_inputrec*                 inputrec,
-                   gmx_mtop_t*                 mtop,
-                   PartialDeserializedTprFile* partialDeserializedTpr);
+/*! \brief Broadcast inputrec and mtop and allocate node-specific settings
+ *
+ * With thread-MPI, all ranks share the global topology read by the
+ * master rank through \p globalTopology instead of each deserializing
+ * a copy, so the topology must not be modified after this call.
+ */
+void init_parallel(MPI_Comm                     communicator,
+                   bool                         isMasterRank,
+                   t_inputrec*                  inputrec,
+                   std::shared_ptr<gmx_mtop_t>* globalTopology,
+                   PartialDeserializedTprFile*  partialDeserializedTpr);
 
 #endif
@@ -46,6 +46,7 @@
 
 #include "gromacs/math/vec.h"
 #include "gromacs/math/vectypes.h"
+#include "gromacs/mdlib/accumulation.h"
 #include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/pbcutil/ishift.h"
 #include "gromacs/pbcutil/pbc.h"
@@ -68,9 +69,23 @@ static void upd_vir(rvec vir, real dvx, real dvy, real dvz)
     vir[ZZ] -= 0.5 * dvz;
 }
 
-static void calc_x_times_f(int nxf, const rvec x[], const rvec f[], gmx_bool bScrewPBC, const matrix box, matrix x_times_f)
+//! The sum over atoms of x times f, accumulated in accum_real
+typedef accum_real XTimesFSum[DIM][DIM];
+
+static void calc_x_times_f(int          nxf,
+                           const rvec   x[],
+                           const rvec   f[],
+                           gmx_bool     bScrewPBC,
+                           const matrix box,
+                           XTimesFSum   x_times_f)
 {
-    clear_mat(x_times_f);
+    for (int d = 0; d < DIM; d++)
+    {
+        for (int n = 0; n < DIM; n++)
+        {
+            x_times_f[d][n] = 0;
+        }
+    }
 
     for (int i = 0; i < nxf; i++)
     {
@@ -102,7 +117,7 @@ static void calc_x_times_f(int nxf, const rvec x[], const rvec f[], gmx_bool bSc
 
 void calc_vir(int nxf, const rvec x[], const rvec f[], tensor vir, bool bScrewPBC, const matrix box)
 {
-    matrix x_times_f;
+    XTimesFSum x_times_f;
 
     int nthreads = gmx_omp_nthreads_get_simple_rvec_task(emntDefault, nxf * 9);
 
@@ -115,10 +130,10 @@ void calc_vir(int nxf, const rvec x[], const rvec f[], tensor vir, bool bScrewPB
     else
     {
         /* Use a buffer on the stack for storing thread-local results.
-         * We use 2 extra elements (=18 reals) per thread to separate thread
+         * We use 2 extra elements (=18 values) per thread to separate thread
          * local data by at least a cache line. Element 0 is not used.
          */
-        matrix xf_buf[GMX_OPENMP_MAX_THREADS * 3];
+        XTimesFSum xf_buf[GMX_OPENMP_MAX_THREADS * 3];
 
 #pragma omp parallel for num_threads(nthreads) schedule(static)
         for (int thread = 0; thread < nthreads; thread++)
@@ -132,7 +147,13 @@ void calc_vir(int nxf, const rvec x[], const rvec f[], tensor vir, bool bScrewPB
 
         for (int thread = 1; thread < nthreads; thread++)
         {
-            m_add(x_times_f, xf_buf[thread * 3], x_times_f);
+            for (int d = 0; d < DIM; d++)
+            {
+                for (int n = 0; n < DIM; n++)
+                {
+                    x_times_f[d][n] += xf_buf[thread * 3][d][n];
+                }
+            }
         }
     }
 
@@ -1166,11 +1166,17 @@ void init_forcerec(FILE*                            fp,
         gmx::assertMtsRequirements(*ir);
     }
 
+    const bool pullAtMtsLevel1 =
+            ir->bPull && gmx::forceGroupMtsLevel(ir->mtsLevels, gmx::MtsForceGroups::Pull) == 1;
     const bool haveDirectVirialContributionsFast =
-            fr->forceProviders->hasForceProvider() || gmx_mtop_ftype_count(mtop, F_POSRES) > 0
-            || gmx_mtop_ftype_count(mtop, F_FBPOSRES) > 0 || ir->nwall > 0 || ir->bPull || ir->bRot
-            || ir->bIMD;
-    const bool haveDirectVirialContributionsSlow = EEL_FULL(ic->eeltype) || EVDW_PME(ic->vdwtype);
+            fr->forceProviders->hasForceProvider(gmx::ForceProviderTimeScale::Fast)
+            || gmx_mtop_ftype_count(mtop, F_POSRES) > 0
+            || gmx_mtop_ftype_count(mtop, F_FBPOSRES) > 0 || ir->nwall > 0
+            || (ir->bPull && !pullAtMtsLevel1) || ir->bRot || ir->bIMD;
+    const bool haveDirectVirialContributionsSlow =
+            EEL_FULL(ic->eeltype) || EVDW_PME(ic->vdwtype)
+            || fr->forceProviders->hasForceProvider(gmx::ForceProviderTimeScale::Slow)
+            || pullAtMtsLevel1;
     for (int i = 0; i < (fr->useMts ? 2 : 1); i++)
     {
         bool haveDirectVirialContributions =
@@ -50,6 +50,7 @@
 #include "gromacs/gmxlib/nrnb.h"
 #include "gromacs/math/utilities.h"
 #include "gromacs/math/vec.h"
+#include "gromacs/mdlib/accumulation.h"
 #include "gromacs/mdlib/coupling.h"
 #include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/mdlib/simulationsignal.h"
@@ -80,6 +81,28 @@
 #include "gromacs/utility/smalloc.h"
 #include "gromacs/utility/snprintf.h"
 
+/*! \brief Adds the accumulated diagonal and off-diagonal (XY, XZ, YZ) elements to symmetric
+ * tensor \p t and clears the accumulators */
+static inline void addSymmetricTensorElements(accum_real diag[DIM],
+                                              accum_real offDiag[DIM],
+                                              tensor     t)
+{
+    t[XX][XX] += diag[XX];
+    t[YY][YY] += diag[YY];
+    t[ZZ][ZZ] += diag[ZZ];
+    t[XX][YY] += offDiag[XX];
+    t[YY][XX] += offDiag[XX];
+    t[XX][ZZ] += offDiag[YY];
+    t[ZZ][XX] += offDiag[YY];
+    t[YY][ZZ] += offDiag[ZZ];
+    t[ZZ][YY] += offDiag[ZZ];
+    for (int d = 0; d < DIM; d++)
+    {
+        diag[d]    = 0;
+        offDiag[d] = 0;
+    }
+}
+
 static void calc_ke_part_normal(gmx::ArrayRef<const gmx::RVec> v,
                                 const t_grpopts*               opts,
                                 const t_mdatoms*               md,
@@ -126,9 +149,12 @@ static void calc_ke_part_normal(gmx::ArrayRef<const gmx::RVec> v,
         int     ga, gt;
         rvec    v_corrt;
         real    hm;
-        int     d, m;
         matrix* ekin_sum;
         real*   dekindl_sum;
+        /* The diagonal and the off-diagonal (XY, XZ, YZ) elements of the kinetic energy tensor */
+        accum_real ekinDiag[DIM]    = { 0 };
+        accum_real ekinOffDiag[DIM] = { 0 };
+        accum_real dekindl          = 0;
 
         start_t = ((thread + 0) * md->homenr) / nthread;
         end_t   = ((thread + 1) * md->homenr) / nthread;
@@ -140,8 +166,12 @@ static void calc_ke_part_normal(gmx::ArrayRef<const gmx::RVec> v,
         {
             clear_mat(ekin_sum[gt]);
         }
-        *dekindl_sum = 0.0;
 
+        /* The kinetic energy tensor is symmetric, so we only accumulate its 6 unique
+         * elements. As atoms in the same T-coupling group are mostly consecutive,
+         * we accumulate in local variables and only add to the group buffer when
+         * the group changes.
+         */
         ga = 0;
         gt = 0;
         for (n = start_t; n < end_t; n++)
@@ -150,29 +180,28 @@ static void calc_ke_part_normal(gmx::ArrayRef<const gmx::RVec> v,
             {
                 ga = md->cACC[n];
             }
-            if (md->cTC)
+            if (md->cTC && md->cTC[n] != gt)
             {
+                addSymmetricTensorElements(ekinDiag, ekinOffDiag, ekin_sum[gt]);
                 gt = md->cTC[n];
             }
             hm = 0.5 * md->massT[n];
 
-            for (d = 0; (d < DIM); d++)
-            {
-                v_corrt[d] = v[n][d] - grpstat[ga].u[d];
-            }
-            for (d = 0; (d < DIM); d++)
-            {
-                for (m = 0; (m < DIM); m++)
-                {
-                    /* if we're computing a full step velocity, v_corrt[d] has v(t).  Otherwise, v(t+dt/2) */
-                    ekin_sum[gt][m][d] += hm * v_corrt[m] * v_corrt[d];
-                }
-            }
+            /* if we're computing a full step velocity, v_corrt has v(t).  Otherwise, v(t+dt/2) */
+            rvec_sub(v[n], grpstat[ga].u, v_corrt);
+            ekinDiag[XX] += hm * v_corrt[XX] * v_corrt[XX];
+            ekinDiag[YY] += hm * v_corrt[YY] * v_corrt[YY];
+            ekinDiag[ZZ] += hm * v_corrt[ZZ] * v_corrt[ZZ];
+            ekinOffDiag[XX] += hm * v_corrt[XX] * v_corrt[YY];
+            ekinOffDiag[YY] += hm * v_corrt[XX] * v_corrt[ZZ];
+            ekinOffDiag[ZZ] += hm * v_corrt[YY] * v_corrt[ZZ];
             if (md->nMassPerturbed && md->bPerturbed[n])
             {
-                *dekindl_sum += 0.5 * (md->massB[n] - md->massA[n]) * iprod(v_corrt, v_corrt);
+                dekindl += 0.5 * (md->massB[n] - md->massA[n]) * iprod(v_corrt, v_corrt);
             }
         }
+        addSymmetricTensorElements(ekinDiag, ekinOffDiag, ekin_sum[gt]);
+        *dekindl_sum = dekindl;
     }
 
     ekind->dekindl = 0;
@@ -63,11 +63,15 @@
 #include "gromacs/utility/futil.h"
 #include "gromacs/utility/smalloc.h"
 
+//! The number of unique elements of a symmetric tensor
+static constexpr int c_numSymmetricTensorElements = 6;
+
 typedef struct gmx_global_stat
 {
     t_bin* rb;
-    int*   itc0;
-    int*   itc1;
+    /* Buffers for the unique elements of the kinetic energy tensors of all T-coupling groups */
+    real* ekin0Packed;
+    real* ekin1Packed;
 } t_gmx_global_stat;
 
 gmx_global_stat_t global_stat_init(const t_inputrec* ir)
@@ -77,8 +81,8 @@ gmx_global_stat_t global_stat_init(const t_inputrec* ir)
     snew(gs, 1);
 
     gs->rb = mk_bin();
-    snew(gs->itc0, ir->opts.ngtc);
-    snew(gs->itc1, ir->opts.ngtc);
+    snew(gs->ekin0Packed, c_numSymmetricTensorElements * ir->opts.ngtc);
+    snew(gs->ekin1Packed, c_numSymmetricTensorElements * ir->opts.ngtc);
 
     return gs;
 }
@@ -86,11 +90,48 @@ gmx_global_stat_t global_stat_init(const t_inputrec* ir)
 void global_stat_destroy(gmx_global_stat_t gs)
 {
     destroy_bin(gs->rb);
-    sfree(gs->itc0);
-    sfree(gs->itc1);
+    sfree(gs->ekin0Packed);
+    sfree(gs->ekin1Packed);
     sfree(gs);
 }
 
+/*! \brief Packs the unique elements of the symmetric tensors \p member of all groups
+ *
+ * Kinetic energy tensors are symmetric, so only 6 of their 9 elements need to be summed.
+ */
+static void packSymmetricTensors(gmx::ArrayRef<const t_grp_tcstat> tcstat,
+                                 tensor t_grp_tcstat::*            member,
+                                 real*                             packed)
+{
+    for (const t_grp_tcstat& grp : tcstat)
+    {
+        const tensor& t = grp.*member;
+        *packed++       = t[XX][XX];
+        *packed++       = t[YY][YY];
+        *packed++       = t[ZZ][ZZ];
+        *packed++       = t[YY][XX];
+        *packed++       = t[ZZ][XX];
+        *packed++       = t[ZZ][YY];
+    }
+}
+
+//! Unpacks symmetric tensors packed by packSymmetricTensors()
+static void unpackSymmetricTensors(const real*                 packed,
+                                   gmx::ArrayRef<t_grp_tcstat> tcstat,
+                                   tensor t_grp_tcstat::*      member)
+{
+    for (t_grp_tcstat& grp : tcstat)
+    {
+        tensor& t = grp.*member;
+        t[XX][XX] = *packed++;
+        t[YY][YY] = *packed++;
+        t[ZZ][ZZ] = *packed++;
+        t[YY][XX] = t[XX][YY] = *packed++;
+        t[ZZ][XX] = t[XX][ZZ] = *packed++;
+        t[ZZ][YY] = t[YY][ZZ] = *packed++;
+    }
+}
+
 static int filter_enerdterm(const real* afrom, gmx_bool bToBuffer, real* ato, gmx_bool bTemp, gmx_bool bPres, gmx_bool bEner)
 {
     int i, to, from;
@@ -153,7 +194,7 @@ void global_stat(const gmx_global_stat*  gs,
 /* instead of current system, gmx_booleans for summing virial, kinetic energy, and other terms */
 {
     t_bin* rb;
-    int *  itc0, *itc1;
+    int    itc0 = 0, itc1 = 0;
     int    ie = 0, ifv = 0, isv = 0, irmsd = 0;
     int idedl = 0, idedlo = 0, idvdll = 0, idvdlnl = 0, iepl = 0, icm = 0, imass = 0, ica = 0, inb = 0;
     int      isig = -1;
@@ -173,9 +214,7 @@ void global_stat(const gmx_global_stat*  gs,
     bEkinAveVel = (inputrec->eI == eiVV || (inputrec->eI == eiVVAK && bPres));
     bReadEkin   = ((flags & CGLO_READEKIN) != 0);
 
-    rb   = gs->rb;
-    itc0 = gs->itc0;
-    itc1 = gs->itc1;
+    rb = gs->rb;
 
 
     reset_bin(rb);
@@ -202,20 +241,18 @@ void global_stat(const gmx_global_stat*  gs,
     {
         if (ekind)
         {
-            for (j = 0; (j < inputrec->opts.ngtc); j++)
+            const int numPackedElements = c_numSymmetricTensorElements * inputrec->opts.ngtc;
+            if (bSumEkinhOld)
             {
-                if (bSumEkinhOld)
-                {
-                    itc0[j] = add_binr(rb, DIM * DIM, ekind->tcstat[j].ekinh_old[0]);
-                }
-                if (bEkinAveVel && !bReadEkin)
-                {
-                    itc1[j] = add_binr(rb, DIM * DIM, ekind->tcstat[j].ekinf[0]);
-                }
-                else if (!bReadEkin)
-                {
-                    itc1[j] = add_binr(rb, DIM * DIM, ekind->tcstat[j].ekinh[0]);
-                }
+                packSymmetricTensors(ekind->tcstat, &t_grp_tcstat::ekinh_old, gs->ekin0Packed);
+                itc0 = add_binr(rb, numPackedElements, gs->ekin0Packed);
+            }
+            if (!bReadEkin)
+            {
+                packSymmetricTensors(ekind->tcstat,
+                                     bEkinAveVel ? &t_grp_tcstat::ekinf : &t_grp_tcstat::ekinh,
+                                     gs->ekin1Packed);
+                itc1 = add_binr(rb, numPackedElements, gs->ekin1Packed);
             }
             /* these probably need to be put into one of these categories */
             idedl = add_binr(rb, 1, &(ekind->dekindl));
@@ -305,20 +342,17 @@ void global_stat(const gmx_global_stat*  gs,
     {
         if (ekind)
         {
-            for (j = 0; (j < inputrec->opts.ngtc); j++)
+            const int numPackedElements = c_numSymmetricTensorElements * inputrec->opts.ngtc;
+            if (bSumEkinhOld)
             {
-                if (bSumEkinhOld)
-                {
-                    extract_binr(rb, itc0[j], DIM * DIM, ekind->tcstat[j].ekinh_old[0]);
-                }
-                if (bEkinAveVel && !bReadEkin)
-                {
-                    extract_binr(rb, itc1[j], DIM * DIM, ekind->tcstat[j].ekinf[0]);
-                }
-                else if (!bReadEkin)
-                {
-                    extract_binr(rb, itc1[j], DIM * DIM, ekind->tcstat[j].ekinh[0]);
-                }
+                extract_binr(rb, itc0, numPackedElements, gs->ekin0Packed);
+                unpackSymmetricTensors(gs->ekin0Packed, ekind->tcstat, &t_grp_tcstat::ekinh_old);
+            }
+            if (!bReadEkin)
+            {
+                extract_binr(rb, itc1, numPackedElements, gs->ekin1Packed);
+                unpackSymmetricTensors(gs->ekin1Packed, ekind->tcstat,
+                                       bEkinAveVel ? &t_grp_tcstat::ekinf : &t_grp_tcstat::ekinh);
             }
             extract_binr(rb, idedl, 1, &(ekind->dekindl));
             if (bSumEkinhOld)
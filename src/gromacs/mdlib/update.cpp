@@ -43,6 +43,7 @@
 #include <cstdio>
 
 #include <algorithm>
+#include <array>
 #include <memory>
 
 #include "gromacs/domdec/domdec_struct.h"
@@ -1014,6 +1015,54 @@ void Update::setNumAtoms(int numAtoms)
     impl_->xp()->resizeWithPadding(numAtoms);
 }
 
+//! The number of table bits for normally distributed random numbers in the SD and BD updates
+static constexpr int c_updateNormalTableBits = 14;
+
+//! The number of atoms for which random bits are generated at once in the SD and BD updates
+static constexpr int c_randomBitsBatchSize = 64;
+
+//! Random bits for a batch of atoms in the SD and BD updates
+using UpdateRandomBits = std::array<uint64_t, c_randomBitsBatchSize>;
+
+/*! \brief Generates the random bits for the update of local atoms \p start to \p end
+ *
+ * The bits for an atom are the first 64-bit value of the ThreeFry2x64 stream
+ * that is restarted with the step and the global atom index as counter.
+ * These provide normal distribution table indices for all three dimensions.
+ * The streams of all atoms in the batch are generated at once, which
+ * vectorizes, and the result is bitwise identical to restarting a scalar
+ * engine for each atom.
+ */
+static void generateUpdateRandomBits(int64_t           step,
+                                     int               seed,
+                                     const int*        gatindex,
+                                     int               start,
+                                     int               end,
+                                     UpdateRandomBits* randomBits)
+{
+    GMX_ASSERT(end - start <= c_randomBitsBatchSize, "The batch should fit in the buffer");
+
+    UpdateRandomBits counters;
+    for (int n = start; n < end; n++)
+    {
+        counters[n - start] = gatindex ? gatindex[n] : n;
+    }
+    gmx::threeFry2x64FirstValues<20>(seed, gmx::RandomDomain::UpdateCoordinates, step,
+                                     gmx::arrayRefFromArray(counters.data(), end - start),
+                                     gmx::arrayRefFromArray(randomBits->data(), end - start));
+}
+
+//! Returns a normal random number from the lowest bits of \p randomBits and consumes these bits
+static inline real normalFromRandomBits(uint64_t* randomBits)
+{
+    using NormalDistribution = gmx::TabulatedNormalDistribution<real, c_updateNormalTableBits>;
+
+    const real value = NormalDistribution::valueFromBits(*randomBits);
+    *randomBits >>= c_updateNormalTableBits;
+
+    return value;
+}
+
 /*! \brief Sets the SD update type */
 enum class SDUpdate : int
 {
@@ -1073,15 +1122,18 @@ static void doSDUpdateGeneral(const gmx_stochd_t&  sd,
         GMX_ASSERT(f != nullptr, "SD update with forces and noise requires forces");
     }
 
-    // Even 0 bits internal counter gives 2x64 ints (more than enough for three table lookups)
-    gmx::ThreeFry2x64<0>                       rng(seed, gmx::RandomDomain::UpdateCoordinates);
-    gmx::TabulatedNormalDistribution<real, 14> dist;
+    // A single 64-bit value per atom is enough for three table lookups
+    UpdateRandomBits randomBits = {};
 
     for (int n = start; n < nrend; n++)
     {
-        int globalAtomIndex = gatindex ? gatindex[n] : n;
-        rng.restart(step, globalAtomIndex);
-        dist.reset();
+        const int indexInBatch = (n - start) % c_randomBitsBatchSize;
+        if (updateType != SDUpdate::ForcesOnly && indexInBatch == 0)
+        {
+            generateUpdateRandomBits(step, seed, gatindex, n,
+                                     std::min(n + c_randomBitsBatchSize, nrend), &randomBits);
+        }
+        uint64_t atomRandomBits = randomBits[indexInBatch];
 
         real inverseMass = invmass[n];
         real invsqrtMass = std::sqrt(inverseMass);
@@ -1105,7 +1157,8 @@ static void doSDUpdateGeneral(const gmx_stochd_t&  sd,
                 {
                     real vn = v[n][d];
                     v[n][d] = (vn * sd.sdc[temperatureGroup].em
-                               + invsqrtMass * sd.sdsig[temperatureGroup].V * dist(rng));
+                               + invsqrtMass * sd.sdsig[temperatureGroup].V
+                                 * normalFromRandomBits(&atomRandomBits));
                     // The previous phase already updated the
                     // positions with a full v*dt term that must
                     // now be half removed.
@@ -1115,7 +1168,8 @@ static void doSDUpdateGeneral(const gmx_stochd_t&  sd,
                 {
                     real vn = v[n][d] + (inverseMass * f[n][d] + accel[accelerationGroup][d]) * dt;
                     v[n][d] = (vn * sd.sdc[temperatureGroup].em
-                               + invsqrtMass * sd.sdsig[temperatureGroup].V * dist(rng));
+                               + invsqrtMass * sd.sdsig[temperatureGroup].V
+                                 * normalFromRandomBits(&atomRandomBits));
                     // Here we include half of the friction+noise
                     // update of v into the position update.
                     xprime[n][d] = x[n][d] + 0.5 * (vn + v[n][d]) * dt;
@@ -1195,10 +1249,8 @@ static void do_update_bd(int         start,
     real vn;
     real invfr = 0;
     int  n, d;
-    // Use 1 bit of internal counters to give us 2*2 64-bits values per stream
     // Each 64-bit value is enough for 4 normal distribution table numbers.
-    gmx::ThreeFry2x64<0>                       rng(seed, gmx::RandomDomain::UpdateCoordinates);
-    gmx::TabulatedNormalDistribution<real, 14> dist;
+    UpdateRandomBits randomBits;
 
     if (friction_coefficient != 0)
     {
@@ -1207,10 +1259,13 @@ static void do_update_bd(int         start,
 
     for (n = start; (n < nrend); n++)
     {
-        int ng = gatindex ? gatindex[n] : n;
-
-        rng.restart(step, ng);
-        dist.reset();
+        const int indexInBatch = (n - start) % c_randomBitsBatchSize;
+        if (indexInBatch == 0)
+        {
+            generateUpdateRandomBits(step, seed, gatindex, n,
+                                     std::min(n + c_randomBitsBatchSize, nrend), &randomBits);
+        }
+        uint64_t atomRandomBits = randomBits[indexInBatch];
 
         if (cFREEZE)
         {
@@ -1226,13 +1281,14 @@ static void do_update_bd(int         start,
             {
                 if (friction_coefficient != 0)
                 {
-                    vn = invfr * f[n][d] + rf[gt] * dist(rng);
+                    vn = invfr * f[n][d] + rf[gt] * normalFromRandomBits(&atomRandomBits);
                 }
                 else
                 {
                     /* NOTE: invmass = 2/(mass*friction_constant*dt) */
                     vn = 0.5 * invmass[n] * f[n][d] * dt
-                         + std::sqrt(0.5 * invmass[n]) * rf[gt] * dist(rng);
+                         + std::sqrt(0.5 * invmass[n]) * rf[gt]
+                                   * normalFromRandomBits(&atomRandomBits);
                 }
 
                 v[n][d]      = vn;
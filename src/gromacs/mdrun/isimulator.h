@@ -128,7 +128,7 @@ public:
                         ImdSession*                         imdSession,
                         pull_t*                             pull_work,
                         t_swap*                             swap,
-                        gmx_mtop_t*                         top_global,
+                        const gmx_mtop_t*                   top_global,
                         t_state*                            state_global,
                         ObservablesHistory*                 observablesHistory,
                         MDAtoms*                            mdAtoms,
@@ -1636,6 +1636,253 @@ void LegacySimulator::do_cg()
 }
 
 
+namespace
+{
+
+/*! \brief Exchanges per-atom vectors for L-BFGS between the local atom order
+ * of an energy-minimization state and a static block distribution of atoms.
+ *
+ * With domain decomposition, atoms change domain and local order at every
+ * repartitioning. The L-BFGS correction vectors therefore live in a block
+ * distribution of the global atom indices over the PP ranks, which does not
+ * change, so dot products over them only need a global sum. Without domain
+ * decomposition the block contains all atoms in global order and the
+ * exchanges are plain copies.
+ */
+class LbfgsAtomDistribution
+{
+public:
+    //! Sets up the block distribution of \p numAtomsGlobal atoms
+    LbfgsAtomDistribution(const t_commrec* cr, int numAtomsGlobal) : cr_(cr)
+    {
+        const int numRanks = DOMAINDECOMP(cr) ? cr->dd->nnodes : 1;
+        const int rank     = DOMAINDECOMP(cr) ? cr->dd->rank : 0;
+
+        blockStarts_.resize(numRanks + 1);
+        for (int r = 0; r <= numRanks; r++)
+        {
+            blockStarts_[r] =
+                    static_cast<int>((static_cast<int64_t>(numAtomsGlobal) * r) / numRanks);
+        }
+        blockStart_     = blockStarts_[rank];
+        numBlockAtoms_  = blockStarts_[rank + 1] - blockStart_;
+        numAtomsGlobal_ = numAtomsGlobal;
+    }
+
+    //! Returns the global index of the first atom in the block of this rank
+    int blockStart() const { return blockStart_; }
+
+    //! Returns the number of atoms in the block of this rank
+    int numBlockAtoms() const { return numBlockAtoms_; }
+
+    //! Returns the number of home atoms of \p ems
+    int numHomeAtoms(const em_state_t& ems) const
+    {
+        return DOMAINDECOMP(cr_) ? gmx::ssize(ems.s.cg_gl) : numAtomsGlobal_;
+    }
+
+    //! Copies the home atom vector \p localVector of \p ems into the block of this rank
+    void gatherToBlock(const em_state_t& ems, ArrayRef<const RVec> localVector,
+                       ArrayRef<RVec> blockVector)
+    {
+        if (!DOMAINDECOMP(cr_))
+        {
+            std::copy(localVector.begin(), localVector.begin() + numAtomsGlobal_,
+                      blockVector.begin());
+            return;
+        }
+#if GMX_MPI
+        setupExchange(ems.s.cg_gl);
+        for (size_t i = 0; i < sendOrder_.size(); i++)
+        {
+            sendValues_[i] = localVector[sendOrder_[i]];
+        }
+        exchangeValues(sendCounts_, sendDispl_, sendValues_, recvCounts_, recvDispl_, &recvValues_);
+        for (size_t i = 0; i < recvIndices_.size(); i++)
+        {
+            blockVector[recvIndices_[i] - blockStart_] = recvValues_[i];
+        }
+#else
+        GMX_UNUSED_VALUE(ems);
+        GMX_UNUSED_VALUE(blockVector);
+#endif
+    }
+
+    //! Copies the block vector of this rank into the home atom vector \p localVector of \p ems
+    void scatterFromBlock(ArrayRef<const RVec> blockVector,
+                          const em_state_t&    ems,
+                          ArrayRef<RVec>       localVector)
+    {
+        if (!DOMAINDECOMP(cr_))
+        {
+            std::copy(blockVector.begin(), blockVector.end(), localVector.begin());
+            return;
+        }
+#if GMX_MPI
+        // The requests for atom values are sent in the same way as a gather,
+        // the values are returned along the reversed communication pattern.
+        setupExchange(ems.s.cg_gl);
+        for (size_t i = 0; i < recvIndices_.size(); i++)
+        {
+            recvValues_[i] = blockVector[recvIndices_[i] - blockStart_];
+        }
+        exchangeValues(recvCounts_, recvDispl_, recvValues_, sendCounts_, sendDispl_, &sendValues_);
+        for (size_t i = 0; i < sendOrder_.size(); i++)
+        {
+            localVector[sendOrder_[i]] = sendValues_[i];
+        }
+#else
+        GMX_UNUSED_VALUE(ems);
+        GMX_UNUSED_VALUE(localVector);
+#endif
+    }
+
+private:
+#if GMX_MPI
+    //! Sorts the home atoms by block and communicates their global indices to the block owners
+    void setupExchange(ArrayRef<const int> homeAtomGlobalIndices)
+    {
+        const int numRanks = cr_->dd->nnodes;
+
+        sendCounts_.assign(numRanks, 0);
+        homeAtomRanks_.resize(homeAtomGlobalIndices.size());
+        for (size_t i = 0; i < homeAtomGlobalIndices.size(); i++)
+        {
+            const int rank = blockOwner(homeAtomGlobalIndices[i]);
+            homeAtomRanks_[i] = rank;
+            sendCounts_[rank]++;
+        }
+        sendDispl_.resize(numRanks + 1);
+        sendDispl_[0] = 0;
+        for (int r = 0; r < numRanks; r++)
+        {
+            sendDispl_[r + 1] = sendDispl_[r] + sendCounts_[r];
+        }
+        std::vector<int> position(sendDispl_.begin(), sendDispl_.end() - 1);
+        sendOrder_.resize(homeAtomGlobalIndices.size());
+        sendIndices_.resize(homeAtomGlobalIndices.size());
+        for (size_t i = 0; i < homeAtomGlobalIndices.size(); i++)
+        {
+            const int pos     = position[homeAtomRanks_[i]]++;
+            sendOrder_[pos]   = i;
+            sendIndices_[pos] = homeAtomGlobalIndices[i];
+        }
+
+        recvCounts_.resize(numRanks);
+        MPI_Alltoall(sendCounts_.data(), 1, MPI_INT, recvCounts_.data(), 1, MPI_INT,
+                     cr_->dd->mpi_comm_all);
+        recvDispl_.resize(numRanks + 1);
+        recvDispl_[0] = 0;
+        for (int r = 0; r < numRanks; r++)
+        {
+            recvDispl_[r + 1] = recvDispl_[r] + recvCounts_[r];
+        }
+        recvIndices_.resize(recvDispl_[numRanks]);
+        MPI_Alltoallv(sendIndices_.data(), sendCounts_.data(), sendDispl_.data(), MPI_INT,
+                      recvIndices_.data(), recvCounts_.data(), recvDispl_.data(), MPI_INT,
+                      cr_->dd->mpi_comm_all);
+
+        sendValues_.resize(sendIndices_.size());
+        recvValues_.resize(recvIndices_.size());
+    }
+
+    //! Sends RVec values with the given atom counts and displacements
+    void exchangeValues(ArrayRef<const int> sendCounts,
+                        ArrayRef<const int> sendDispl,
+                        ArrayRef<const RVec> sendValues,
+                        ArrayRef<const int>  recvCounts,
+                        ArrayRef<const int>  recvDispl,
+                        std::vector<RVec>*   recvValues)
+    {
+        const int numRanks = cr_->dd->nnodes;
+
+        valueSendCounts_.resize(numRanks);
+        valueSendDispl_.resize(numRanks);
+        valueRecvCounts_.resize(numRanks);
+        valueRecvDispl_.resize(numRanks);
+        for (int r = 0; r < numRanks; r++)
+        {
+            valueSendCounts_[r] = DIM * sendCounts[r];
+            valueSendDispl_[r]  = DIM * sendDispl[r];
+            valueRecvCounts_[r] = DIM * recvCounts[r];
+            valueRecvDispl_[r]  = DIM * recvDispl[r];
+        }
+        MPI_Alltoallv(const_cast<RVec*>(sendValues.data()), valueSendCounts_.data(),
+                      valueSendDispl_.data(), GMX_MPI_REAL, recvValues->data(),
+                      valueRecvCounts_.data(), valueRecvDispl_.data(), GMX_MPI_REAL,
+                      cr_->dd->mpi_comm_all);
+    }
+
+    //! Returns the rank whose block contains global atom \p globalAtomIndex
+    int blockOwner(int globalAtomIndex) const
+    {
+        const auto next =
+                std::upper_bound(blockStarts_.begin(), blockStarts_.end(), globalAtomIndex);
+        return static_cast<int>(next - blockStarts_.begin()) - 1;
+    }
+#endif
+
+    //! Communication record
+    const t_commrec* cr_;
+    //! The first global atom index of the block of each rank, and the total number of atoms
+    std::vector<int> blockStarts_;
+    //! The first global atom index of the block of this rank
+    int blockStart_ = 0;
+    //! The number of atoms in the block of this rank
+    int numBlockAtoms_ = 0;
+    //! The total number of atoms
+    int numAtomsGlobal_ = 0;
+#if GMX_MPI
+    //! Block owner rank for each home atom
+    std::vector<int> homeAtomRanks_;
+    //! Local home atom index for each entry in the send buffers
+    std::vector<int> sendOrder_;
+    //! Global atom indices sent, sorted by block owner
+    std::vector<int> sendIndices_;
+    //! Number of atoms sent to each rank
+    std::vector<int> sendCounts_;
+    //! Displacements in the send buffers for each rank
+    std::vector<int> sendDispl_;
+    //! Global atom indices received from each rank
+    std::vector<int> recvIndices_;
+    //! Number of atoms received from each rank
+    std::vector<int> recvCounts_;
+    //! Displacements in the receive buffers for each rank
+    std::vector<int> recvDispl_;
+    //! Values in the order of the send buffers
+    std::vector<RVec> sendValues_;
+    //! Values in the order of the receive buffers
+    std::vector<RVec> recvValues_;
+    //! Counts and displacements in units of real for the value exchange
+    std::vector<int> valueSendCounts_, valueSendDispl_, valueRecvCounts_, valueRecvDispl_;
+#endif
+};
+
+/*! \brief Gives an L-BFGS trial state the domain decomposition of the start of the line
+ *
+ * Only the local atom order and the variables that are not set by the step
+ * are copied, as in do_em_step(). The coordinates are set by the trial step.
+ */
+void copyLineStartPartitioning(const em_state_t& lineStart, em_state_t* trialState)
+{
+    const t_state& s1 = lineStart.s;
+    t_state*       s2 = &trialState->s;
+
+    s2->flags = s1.flags;
+    if (s2->natoms != s1.natoms)
+    {
+        state_change_natoms(s2, s1.natoms);
+        trialState->f.resize(s2->natoms);
+    }
+    s2->cg_gl           = s1.cg_gl;
+    s2->ddp_count       = s1.ddp_count;
+    s2->ddp_count_cg_gl = s1.ddp_count_cg_gl;
+    copy_mat(s1.box, s2->box);
+    s2->lambda = s1.lambda;
+}
+
+} // namespace
+
 void LegacySimulator::do_lbfgs()
 {
     static const char* LBFGS = "Low-Memory BFGS Minimizer";
@@ -1665,9 +1912,10 @@ void LegacySimulator::do_lbfgs()
                     "be available in a different form in a future version of GROMACS, "
                     "e.g. gmx minimize and an .mdp option.");
 
-    if (PAR(cr))
+    if (DOMAINDECOMP(cr) && inputrec->pbcType == PbcType::Screw)
     {
-        gmx_fatal(FARGS, "L-BFGS minimization only supports a single rank");
+        gmx_fatal(FARGS,
+                  "L-BFGS minimization with domain decomposition does not support screw pbc");
     }
 
     if (nullptr != constr)
@@ -1678,7 +1926,12 @@ void LegacySimulator::do_lbfgs()
                 "do not use constraints, or use another minimizer (e.g. steepest descent).");
     }
 
-    n        = 3 * state_global->natoms;
+    /* The correction vectors are stored for a fixed block of atoms per rank,
+     * so they are not affected by domain decomposition repartitioning.
+     */
+    LbfgsAtomDistribution atomDistribution(cr, top_global->natoms);
+
+    n        = 3 * atomDistribution.numBlockAtoms();
     nmaxcorr = inputrec->nbfgscorr;
 
     snew(frozen, n);
@@ -1713,7 +1966,7 @@ void LegacySimulator::do_lbfgs()
                                    false, StartingBehavior::NewSimulation, mdModulesNotifier);
 
     start = 0;
-    end   = mdatoms->homenr;
+    end   = atomDistribution.numBlockAtoms();
 
     /* We need 4 working states */
     em_state_t  s0{}, s1{}, s2{}, s3{};
@@ -1738,10 +1991,8 @@ void LegacySimulator::do_lbfgs()
     gf = 0;
     for (i = start; i < end; i++)
     {
-        if (mdatoms->cFREEZE)
-        {
-            gf = mdatoms->cFREEZE[i];
-        }
+        gf = getGroupType(top_global->groups, SimulationAtomGroupType::Freeze,
+                          atomDistribution.blockStart() + i);
         for (m = 0; m < DIM; m++)
         {
             frozen[3 * i + m] = (inputrec->opts.nFreeze[gf][m] != 0);
@@ -1807,13 +2058,52 @@ void LegacySimulator::do_lbfgs()
     // Point is an index to the memory of search directions, where 0 is the first one.
     point = 0;
 
+    /* The force of the current state and the last state in block order */
+    std::vector<RVec> forceBlock(atomDistribution.numBlockAtoms());
+    std::vector<RVec> lastForceBlock(atomDistribution.numBlockAtoms());
+    /* The search direction in the local atom order of the current state */
+    std::vector<RVec> searchDirectionLocal;
+    real*             ff    = reinterpret_cast<real*>(forceBlock.data());
+    real*             lastf = reinterpret_cast<real*>(lastForceBlock.data());
+    atomDistribution.gatherToBlock(ems, ems.f.view().force(), forceBlock);
+
+    /* Returns the line gradient along the search direction s for state ems,
+     * summed over all ranks. The forces are reordered to the block order
+     * of the search direction using the force buffer of the trial states.
+     */
+    std::vector<RVec> trialForceBlock(atomDistribution.numBlockAtoms());
+    auto              lineGradient = [&](const real* s, em_state_t* trialState) {
+        atomDistribution.gatherToBlock(*trialState, trialState->f.view().force(), trialForceBlock);
+        const real* f  = reinterpret_cast<const real*>(trialForceBlock.data());
+        double      gp = 0;
+        for (int i = 0; i < n; i++)
+        {
+            gp -= s[i] * f[i]; /* f is negative gradient, thus the sign */
+        }
+        /* Sum the gradient along the line across CPUs */
+        if (PAR(cr))
+        {
+            gmx_sumd(1, &gp, cr);
+        }
+        return gp;
+    };
+
+    /* Sums a real value computed on this rank over all ranks */
+    auto sumOverRanks = [&](real* value) {
+        if (PAR(cr))
+        {
+            double buffer = *value;
+            gmx_sumd(1, &buffer, cr);
+            *value = buffer;
+        }
+    };
+
     // Set initial search direction to the force (-gradient), or 0 for frozen particles.
-    real* fInit = static_cast<real*>(ems.f.view().force().data()[0]);
     for (i = 0; i < n; i++)
     {
         if (!frozen[i])
         {
-            dx[point][i] = fInit[i]; /* Initial search direction */
+            dx[point][i] = ff[i]; /* Initial search direction */
         }
         else
         {
@@ -1869,29 +2159,50 @@ void LegacySimulator::do_lbfgs()
         /* make s a pointer to current search direction - point=0 first time we get here */
         s = dx[point];
 
+        /* The search direction in the local atom order of the current state,
+         * which is also the order of the trial states along the line.
+         */
+        const int nlocal = 3 * atomDistribution.numHomeAtoms(ems);
+        real*     slocal = s;
+        if (DOMAINDECOMP(cr))
+        {
+            searchDirectionLocal.resize(nlocal / 3);
+            const ArrayRef<const RVec> searchDirectionBlock =
+                    arrayRefFromArray(reinterpret_cast<const RVec*>(s), n / 3);
+            atomDistribution.scatterFromBlock(searchDirectionBlock, ems, searchDirectionLocal);
+            slocal = reinterpret_cast<real*>(searchDirectionLocal.data());
+        }
+
         real* xx = static_cast<real*>(ems.s.x.rvec_array()[0]);
-        real* ff = static_cast<real*>(ems.f.view().force().data()[0]);
 
         // calculate line gradient in position A
         for (gpa = 0, i = 0; i < n; i++)
         {
             gpa -= s[i] * ff[i];
         }
+        if (PAR(cr))
+        {
+            gmx_sumd(1, &gpa, cr);
+        }
 
         /* Calculate minimum allowed stepsize along the line, before the average (norm)
          * relative change in coordinate is smaller than precision
          */
-        for (minstep = 0, i = 0; i < n; i++)
+        for (minstep = 0, i = 0; i < nlocal; i++)
         {
             tmp = fabs(xx[i]);
             if (tmp < 1.0)
             {
                 tmp = 1.0;
             }
-            tmp = s[i] / tmp;
+            tmp = slocal[i] / tmp;
             minstep += tmp * tmp;
         }
-        minstep = GMX_REAL_EPS / sqrt(minstep / n);
+        if (PAR(cr))
+        {
+            gmx_sumd(1, &minstep, cr);
+        }
+        minstep = GMX_REAL_EPS / sqrt(minstep / (3 * top_global->natoms));
 
         if (stepsize < minstep)
         {
@@ -1902,8 +2213,8 @@ void LegacySimulator::do_lbfgs()
         // Before taking any steps along the line, store the old position
         *last       = ems;
         real* lastx = static_cast<real*>(last->s.x.data()[0]);
-        real* lastf = static_cast<real*>(last->f.view().force().data()[0]);
-        Epot0       = ems.epot;
+        std::copy(forceBlock.begin(), forceBlock.end(), lastForceBlock.begin());
+        Epot0 = ems.epot;
 
         *sa = ems;
 
@@ -1947,14 +2258,22 @@ void LegacySimulator::do_lbfgs()
             // Calculate what the largest change in any individual coordinate
             // would be (translation along line * gradient along line)
             maxdelta = 0;
-            for (i = 0; i < n; i++)
+            for (i = 0; i < nlocal; i++)
             {
-                delta = c * s[i];
+                delta = c * slocal[i];
                 if (delta > maxdelta)
                 {
                     maxdelta = delta;
                 }
             }
+#if GMX_MPI
+            if (PAR(cr))
+            {
+                real maxdeltaLocal = maxdelta;
+                MPI_Allreduce(&maxdeltaLocal, &maxdelta, 1, GMX_MPI_REAL, MPI_MAX,
+                              cr->mpi_comm_mygroup);
+            }
+#endif
             // If any displacement is larger than the stepsize limit, reduce the step
             if (maxdelta > inputrec->em_stepsize)
             {
@@ -1962,11 +2281,16 @@ void LegacySimulator::do_lbfgs()
             }
         } while (maxdelta > inputrec->em_stepsize);
 
-        // Take a trial step and move the coordinate array xc[] to position C
+        // Take a trial step and move the coordinate array xc[] to position C.
+        // With DD the trial state needs the local atom order of the last state.
+        if (DOMAINDECOMP(cr))
+        {
+            copyLineStartPartitioning(*last, sc);
+        }
         real* xc = static_cast<real*>(sc->s.x.rvec_array()[0]);
-        for (i = 0; i < n; i++)
+        for (i = 0; i < nlocal; i++)
         {
-            xc[i] = lastx[i] + c * s[i];
+            xc[i] = lastx[i] + c * slocal[i];
         }
 
         neval++;
@@ -1974,16 +2298,7 @@ void LegacySimulator::do_lbfgs()
         energyEvaluator.run(sc, mu_tot, vir, pres, step, FALSE);
 
         // Calc line gradient in position C
-        real* fc = static_cast<real*>(sc->f.view().force()[0]);
-        for (gpc = 0, i = 0; i < n; i++)
-        {
-            gpc -= s[i] * fc[i]; /* f is negative gradient, thus the sign */
-        }
-        /* Sum the gradient along the line across CPUs */
-        if (PAR(cr))
-        {
-            gmx_sumd(1, &gpc, cr);
-        }
+        gpc = lineGradient(s, sc);
 
         // This is the max amount of increase in energy we tolerate.
         // By allowing VERY small changes (close to numerical precision) we
@@ -2044,10 +2359,14 @@ void LegacySimulator::do_lbfgs()
                 }
 
                 // Take a trial step to point B
+                if (DOMAINDECOMP(cr))
+                {
+                    copyLineStartPartitioning(*last, sb);
+                }
                 real* xb = static_cast<real*>(sb->s.x.rvec_array()[0]);
-                for (i = 0; i < n; i++)
+                for (i = 0; i < nlocal; i++)
                 {
-                    xb[i] = lastx[i] + b * s[i];
+                    xb[i] = lastx[i] + b * slocal[i];
                 }
 
                 neval++;
@@ -2056,16 +2375,7 @@ void LegacySimulator::do_lbfgs()
                 fnorm = sb->fnorm;
 
                 // Calculate gradient in point B
-                real* fb = static_cast<real*>(sb->f.view().force()[0]);
-                for (gpb = 0, i = 0; i < n; i++)
-                {
-                    gpb -= s[i] * fb[i]; /* f is negative gradient, thus the sign */
-                }
-                /* Sum the gradient along the line across CPUs */
-                if (PAR(cr))
-                {
-                    gmx_sumd(1, &gpb, cr);
-                }
+                gpb = lineGradient(s, sb);
 
                 // Keep one of the intervals [A,B] or [B,C] based on the value of the derivative
                 // at the new point B, and rename the endpoints of this new interval A and C.
@@ -2147,6 +2457,7 @@ void LegacySimulator::do_lbfgs()
          */
 
         /* Have new data in Epot, xx, ff */
+        atomDistribution.gatherToBlock(ems, ems.f.view().force(), forceBlock);
         if (ncorr < nmaxcorr)
         {
             ncorr++;
@@ -2165,6 +2476,8 @@ void LegacySimulator::do_lbfgs()
             dgdg += dg[point][i] * dg[point][i];
             dgdx += dg[point][i] * dx[point][i];
         }
+        sumOverRanks(&dgdg);
+        sumOverRanks(&dgdx);
 
         diag = dgdx / dgdg;
 
@@ -2198,6 +2511,7 @@ void LegacySimulator::do_lbfgs()
             {
                 sq += dx[cp][i] * p[i];
             }
+            sumOverRanks(&sq);
 
             alpha[cp] = rho[cp] * sq;
 
@@ -2220,6 +2534,7 @@ void LegacySimulator::do_lbfgs()
             {
                 yr += p[i] * dg[cp][i];
             }
+            sumOverRanks(&yr);
 
             beta = rho[cp] * yr;
             beta = alpha[cp] - beta;
@@ -2279,7 +2594,9 @@ void LegacySimulator::do_lbfgs()
         }
 
         /* Send x and E to IMD client, if bIMD is TRUE. */
-        if (imdSession->run(step, TRUE, state_global->box, state_global->x.rvec_array(), 0) && MASTER(cr))
+        if (imdSession->run(step, TRUE, MASTER(cr) ? state_global->box : nullptr,
+                            MASTER(cr) ? state_global->x.rvec_array() : nullptr, 0)
+            && MASTER(cr))
         {
             imdSession->sendPositionsAndEnergies();
         }
@@ -2307,18 +2624,21 @@ void LegacySimulator::do_lbfgs()
         converged = FALSE;
     }
 
-    /* If we printed energy and/or logfile last step (which was the last step)
-     * we don't have to do it again, but otherwise print the final values.
-     */
-    if (!do_log) /* Write final value to log since we didn't do anythin last step */
-    {
-        EnergyOutput::printHeader(fplog, step, step);
-    }
-    if (!do_ene || !do_log) /* Write final energy file entries */
+    if (MASTER(cr))
     {
-        energyOutput.printStepToEnergyFile(mdoutf_get_fp_ene(outf), !do_ene, FALSE, FALSE,
-                                           !do_log ? fplog : nullptr, step, step, fr->fcdata.get(),
-                                           nullptr);
+        /* If we printed energy and/or logfile last step (which was the last step)
+         * we don't have to do it again, but otherwise print the final values.
+         */
+        if (!do_log) /* Write final value to log since we didn't do anythin last step */
+        {
+            EnergyOutput::printHeader(fplog, step, step);
+        }
+        if (!do_ene || !do_log) /* Write final energy file entries */
+        {
+            energyOutput.printStepToEnergyFile(mdoutf_get_fp_ene(outf), !do_ene, FALSE, FALSE,
+                                               !do_log ? fplog : nullptr, step, step,
+                                               fr->fcdata.get(), nullptr);
+        }
     }
 
     /* Print some stuff... */
@@ -2735,6 +3055,10 @@ void LegacySimulator::do_nm()
      *
      ************************************************************/
 
+    /* Buffers for assembling a row of the sparse Hessian */
+    std::vector<int>  sparseRowColumns;
+    std::vector<real> sparseRowValues;
+
     /* Steps are divided one by one over the nodes */
     bool bNS          = true;
     auto state_work_x = makeArrayRef(state_work.s.x);
@@ -2825,21 +3149,37 @@ void LegacySimulator::do_nm()
 
                     row = (aid + node) * DIM + d;
 
-                    for (size_t j = 0; j < atom_index.size(); j++)
+                    if (bSparse)
                     {
-                        for (size_t k = 0; k < DIM; k++)
+                        /* Each row is complete here, so we store it at once
+                         * instead of searching the row for every new element.
+                         */
+                        sparseRowColumns.clear();
+                        sparseRowValues.clear();
+                        for (size_t j = 0; j < atom_index.size(); j++)
                         {
-                            col = j * DIM + k;
-
-                            if (bSparse)
+                            for (size_t k = 0; k < DIM; k++)
                             {
+                                col = j * DIM + k;
+
                                 if (col >= row && dfdx[j][k] != 0.0)
                                 {
-                                    gmx_sparsematrix_increment_value(sparse_matrix, row, col, dfdx[j][k]);
+                                    sparseRowColumns.push_back(col);
+                                    sparseRowValues.push_back(dfdx[j][k]);
                                 }
                             }
-                            else
+                        }
+                        gmx_sparsematrix_set_row(sparse_matrix, row, sparseRowColumns.size(),
+                                                 sparseRowColumns.data(), sparseRowValues.data());
+                    }
+                    else
+                    {
+                        for (size_t j = 0; j < atom_index.size(); j++)
+                        {
+                            for (size_t k = 0; k < DIM; k++)
                             {
+                                col = j * DIM + k;
+
                                 full_matrix[row * sz + col] = dfdx[j][k];
                             }
                         }
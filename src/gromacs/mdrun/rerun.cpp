@@ -48,6 +48,9 @@
 
 #include <algorithm>
 #include <memory>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 #include "gromacs/applied_forces/awh/awh.h"
 #include "gromacs/commandline/filenm.h"
@@ -61,6 +64,8 @@
 #include "gromacs/essentialdynamics/edsam.h"
 #include "gromacs/ewald/pme_load_balancing.h"
 #include "gromacs/ewald/pme_pp.h"
+#include "gromacs/fileio/filetypes.h"
+#include "gromacs/fileio/gmxfio.h"
 #include "gromacs/fileio/trxio.h"
 #include "gromacs/gmxlib/network.h"
 #include "gromacs/gmxlib/nrnb.h"
@@ -114,6 +119,7 @@
 #include "gromacs/mdtypes/observableshistory.h"
 #include "gromacs/mdtypes/state.h"
 #include "gromacs/mimic/utilities.h"
+#include "gromacs/nbnxm/nbnxm.h"
 #include "gromacs/pbcutil/pbc.h"
 #include "gromacs/pulling/pull.h"
 #include "gromacs/swap/swapcoords.h"
@@ -165,6 +171,230 @@ static void prepareRerunState(const t_trxframe&          rerunFrame,
     }
 }
 
+/*! \brief Returns the number of frames in the rerun trajectory
+ *
+ * The frames are read through a separate trajectory status. For XTC and
+ * TRR files, which are read without look-ahead, the file offset of each
+ * frame is stored in \p frameOffsets, so that the rerun can seek directly
+ * to a frame. For other formats \p frameOffsets is left empty.
+ *
+ * \param[in]  oenv          Output environment
+ * \param[in]  filename      The name of the rerun trajectory file
+ * \param[out] frameOffsets  The file offset of each frame, or empty
+ */
+static int countRerunTrajectoryFrames(const gmx_output_env_t* oenv,
+                                      const char*             filename,
+                                      std::vector<gmx_off_t>* frameOffsets)
+{
+    const int  filetype    = fn2ftp(filename);
+    const bool storeOffset = (filetype == efXTC || filetype == efTRR);
+
+    frameOffsets->clear();
+    int          numFrames = 0;
+    t_trxstatus* scanStatus;
+    t_trxframe   frame;
+    if (read_first_frame(oenv, &scanStatus, filename, &frame, 0))
+    {
+        gmx_off_t offset = 0;
+        do
+        {
+            if (storeOffset)
+            {
+                frameOffsets->push_back(offset);
+                offset = gmx_fio_ftell(trx_get_fileio(scanStatus));
+            }
+            numFrames++;
+        } while (read_next_frame(oenv, scanStatus, &frame));
+        close_trx(scanStatus);
+    }
+    done_frame(&frame);
+
+    return numFrames;
+}
+
+/*! \brief Returns the range of frames this simulation processes when the
+ * rerun frames are split over multiple simulations
+ *
+ * The frames of the trajectory are divided into contiguous blocks with
+ * numbers of frames that differ by at most one, one block per simulation
+ * in the order of the simulation index. The energy files of the
+ * simulations can thus be concatenated with gmx eneconv.
+ *
+ * \param[in] ms         Multi-simulation setup
+ * \param[in] numFrames  The number of frames in the trajectory
+ * \returns The index of the first frame and the index past the last frame
+ */
+static std::pair<int, int> rerunFrameBlockOfSimulation(const gmx_multisim_t& ms, int numFrames)
+{
+    const int64_t numBlocks  = ms.numSimulations_;
+    const int64_t blockIndex = ms.simulationIndex_;
+
+    return { static_cast<int>((numFrames * blockIndex) / numBlocks),
+             static_cast<int>((numFrames * (blockIndex + 1)) / numBlocks) };
+}
+
+namespace
+{
+
+//! Maximum pair-list buffer for rerun, with larger buffers non-bonded work dominates search cost
+constexpr real c_maxRerunPairlistBuffer = 0.2;
+
+/*! \brief Decides when the pair list can be reused for the next rerun frame
+ *
+ * A pair list searched with radius rlist contains all pairs within the
+ * interaction cut-off as long as no pair distance has decreased by more than
+ * the buffer rlist - cut-off since the search. We bound the change of pair
+ * distances by twice the maximum atom displacement plus the change of the
+ * periodic images due to box changes. As the search puts the atoms in the box,
+ * the coordinates of later frames are moved to the images used at the search.
+ * These shifted coordinates are also the ones written to the output trajectory.
+ *
+ * At each search, the buffer is chosen such that the list is expected to
+ * last for the pair-list lifetime of the tpr file, using the displacement
+ * per frame observed since the previous search. The buffer is never smaller
+ * than the buffer of the tpr file.
+ */
+class RerunPairlistReuse
+{
+public:
+    /*! \brief Constructor
+     *
+     * \param[in] maxCutoff         The maximum interaction cut-off
+     * \param[in] minPairlistRadius The minimum pair-list radius, the one of the tpr file
+     * \param[in] targetNumFrames   The number of frames a pair list should be used for
+     */
+    RerunPairlistReuse(real maxCutoff, real minPairlistRadius, int targetNumFrames) :
+        maxCutoff_(maxCutoff),
+        minBuffer_(minPairlistRadius - maxCutoff),
+        targetNumFrames_(targetNumFrames)
+    {
+    }
+
+    /*! \brief Moves the coordinates \p x to the periodic images of the last search
+     * and returns whether the pair list of that search is valid for \p x and \p box
+     */
+    bool canReusePairlist(gmx::ArrayRef<gmx::RVec> x, const matrix box)
+    {
+        if (buffer_ < 0)
+        {
+            return false;
+        }
+
+        numFramesSinceSearch_++;
+
+        /* With triclinic boxes, a pair shift can contain up to two box vectors */
+        real boxChange = 0;
+        for (int d = 0; d < DIM; d++)
+        {
+            rvec dBox;
+            rvec_sub(box[d], boxAtSearch_[d], dBox);
+            boxChange += 2 * norm(dBox);
+        }
+        /* Displacements of half a box or more are jumps of molecules over periodic
+         * boundaries in the trajectory, these should not affect the buffer estimate
+         */
+        const real jump2 = 0.25 * gmx::square(std::min({ box[XX][XX], box[YY][YY], box[ZZ][ZZ] }));
+
+        real maxDisplacement2           = 0;
+        real maxContinuousDisplacement2 = 0;
+        for (gmx::index a = 0; a < x.ssize(); a++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                for (int e = 0; e <= d; e++)
+                {
+                    x[a][e] += imageShifts_[a][d] * box[d][e];
+                }
+            }
+            const real displacement2 = gmx::norm2(x[a] - xAtSearch_[a]);
+            maxDisplacement2         = std::max(maxDisplacement2, displacement2);
+            if (displacement2 < jump2)
+            {
+                maxContinuousDisplacement2 = std::max(maxContinuousDisplacement2, displacement2);
+            }
+        }
+
+        if (2 * std::sqrt(maxDisplacement2) + boxChange < buffer_)
+        {
+            return true;
+        }
+
+        displacementPerFrame_ = std::sqrt(maxContinuousDisplacement2) / numFramesSinceSearch_;
+
+        return false;
+    }
+
+    /*! \brief Returns the pair-list radius to use for a search with \p box
+     * and stores the coordinates \p x passed to the search
+     */
+    real startSearch(PbcType pbcType, gmx::ArrayRef<const gmx::RVec> x, const matrix box)
+    {
+        buffer_ = std::clamp(2 * displacementPerFrame_ * targetNumFrames_, minBuffer_,
+                             std::max(minBuffer_, c_maxRerunPairlistBuffer));
+        if (pbcType != PbcType::No)
+        {
+            const real maxBuffer = std::sqrt(max_cutoff2(pbcType, box)) - maxCutoff_;
+            buffer_              = std::max(minBuffer_, std::min(buffer_, maxBuffer));
+        }
+        xBeforeSearch_.assign(x.begin(), x.end());
+
+        return maxCutoff_ + buffer_;
+    }
+
+    /*! \brief Stores the periodic images of the atoms used by the search
+     *
+     * \param[in] x    The coordinates after the search put the atoms in the box
+     * \param[in] box  The box used for the search
+     */
+    void finishSearch(gmx::ArrayRef<const gmx::RVec> x, const matrix box)
+    {
+        imageShifts_.resize(x.size(), { 0, 0, 0 });
+        for (gmx::index a = 0; a < x.ssize(); a++)
+        {
+            gmx::RVec dx = x[a] - xBeforeSearch_[a];
+            for (int d = ZZ; d >= XX; d--)
+            {
+                if (box[d][d] > 0)
+                {
+                    const int shift = static_cast<int>(std::round(dx[d] / box[d][d]));
+                    for (int e = 0; e <= d; e++)
+                    {
+                        dx[e] -= shift * box[d][e];
+                    }
+                    imageShifts_[a][d] += shift;
+                }
+            }
+        }
+        xAtSearch_.assign(x.begin(), x.end());
+        copy_mat(box, boxAtSearch_);
+        numFramesSinceSearch_ = 0;
+    }
+
+private:
+    //! The maximum interaction cut-off
+    real maxCutoff_;
+    //! The minimum pair-list buffer
+    real minBuffer_;
+    //! The number of frames we aim to use a pair list for
+    int targetNumFrames_;
+    //! The buffer of the current pair list, negative when there is no list yet
+    real buffer_ = -1;
+    //! The number of frames processed since the last search
+    int numFramesSinceSearch_ = 0;
+    //! The maximum atom displacement per frame observed during the lifetime of the last list
+    real displacementPerFrame_ = 0;
+    //! The box shifts, relative to the trajectory coordinates, of the atoms at the last search
+    std::vector<gmx::IVec> imageShifts_;
+    //! The coordinates passed to the last search
+    std::vector<gmx::RVec> xBeforeSearch_;
+    //! The coordinates after the last search
+    std::vector<gmx::RVec> xAtSearch_;
+    //! The box at the last search
+    matrix boxAtSearch_ = { { 0 } };
+};
+
+} // namespace
+
 void gmx::LegacySimulator::do_rerun()
 {
     // TODO Historically, the EM and MD "integrators" used different
@@ -183,6 +413,7 @@ void gmx::LegacySimulator::do_rerun()
     t_trxstatus*      status = nullptr;
     rvec              mu_tot;
     t_trxframe        rerun_fr;
+    int               numBlockFramesToRead = 0;
     gmx_localtop_t    top(top_global->ffparams);
     ForceBuffers      f;
     gmx_global_stat_t gstat;
@@ -243,10 +474,12 @@ void gmx::LegacySimulator::do_rerun()
     {
         gmx_fatal(FARGS, "Interactive MD not supported by rerun.");
     }
-    if (isMultiSim(ms))
-    {
-        gmx_fatal(FARGS, "Multiple simulations not supported by rerun.");
-    }
+    /* Multiple simulations rerun their trajectories independently, as no
+     * signals or exchanges are communicated between them. They can also
+     * process contiguous blocks of frames of the same trajectory.
+     */
+    const bool splitFramesOverSimulations =
+            isMultiSim(ms) && (getenv("GMX_RERUN_SPLIT_FRAMES") != nullptr);
     if (std::any_of(ir->opts.annealing, ir->opts.annealing + ir->opts.ngtc,
                     [](int i) { return i != eannNO; }))
     {
@@ -267,6 +500,7 @@ void gmx::LegacySimulator::do_rerun()
     }
 
     /* Settings for rerun */
+    const int nstlistFromTpr = ir->nstlist;
     ir->nstlist              = 1;
     ir->nstcalcenergy        = 1;
     int        nstglobalcomm = 1;
@@ -304,6 +538,30 @@ void gmx::LegacySimulator::do_rerun()
         }
     }
 
+    std::unique_ptr<RerunPairlistReuse> pairlistReuse;
+    if (getenv("GMX_RERUN_REUSE_PAIRLIST") != nullptr)
+    {
+        if (DOMAINDECOMP(cr) || shellfc || ir->pbcType == PbcType::Screw)
+        {
+            GMX_LOG(mdlog.warning)
+                    .asParagraph()
+                    .appendText(
+                            "NOTE: GMX_RERUN_REUSE_PAIRLIST is set, but reusing the pair list "
+                            "is not supported with domain decomposition, shells or screw pbc. "
+                            "The pair list is searched for every frame.");
+        }
+        else
+        {
+            pairlistReuse = std::make_unique<RerunPairlistReuse>(
+                    std::max(ir->rvdw, ir->rcoulomb), fr->rlist, std::max(nstlistFromTpr, 1));
+            GMX_LOG(mdlog.info)
+                    .asParagraph()
+                    .appendText(
+                            "Reusing the pair list between rerun frames while the atom "
+                            "displacements stay within the pair-list buffer.");
+        }
+    }
+
     // Local state only becomes valid now.
     std::unique_ptr<t_state> stateInstance;
     t_state*                 state;
@@ -422,6 +680,47 @@ void gmx::LegacySimulator::do_rerun()
                           rerun_fr.step, rerun_fr.time);
             }
         }
+
+        if (splitFramesOverSimulations && !isLastStep)
+        {
+            std::vector<gmx_off_t> frameOffsets;
+            const int              numFrames =
+                    countRerunTrajectoryFrames(oenv, opt2fn("-rerun", nfile, fnm), &frameOffsets);
+            if (numFrames < ms->numSimulations_)
+            {
+                gmx_fatal(FARGS,
+                          "Cannot split %d rerun frames over %d simulations, there should be at "
+                          "least one frame per simulation",
+                          numFrames, ms->numSimulations_);
+            }
+            int firstFrame, endFrame;
+            std::tie(firstFrame, endFrame) = rerunFrameBlockOfSimulation(*ms, numFrames);
+            numBlockFramesToRead           = endFrame - firstFrame;
+
+            /* Go to the first frame of the block of this simulation */
+            if (firstFrame > 0 && !frameOffsets.empty())
+            {
+                gmx_fio_seek(trx_get_fileio(status), frameOffsets[firstFrame]);
+                isLastStep = !read_next_frame(oenv, status, &rerun_fr);
+            }
+            else
+            {
+                /* TNG and text formats are skipped frame by frame */
+                for (int frame = 0; frame < firstFrame && !isLastStep; frame++)
+                {
+                    isLastStep = !read_next_frame(oenv, status, &rerun_fr);
+                }
+            }
+        }
+    }
+
+    if (splitFramesOverSimulations)
+    {
+        GMX_LOG(mdlog.info)
+                .asParagraph()
+                .appendTextFormatted(
+                        "Splitting the rerun frames over %d simulations, this is simulation %d.",
+                        ms->numSimulations_, ms->simulationIndex_);
     }
 
     GMX_LOG(mdlog.info)
@@ -532,6 +831,18 @@ void gmx::LegacySimulator::do_rerun()
                        | GMX_FORCE_VIRIAL | // TODO: Get rid of this once #2649 and #3400 are solved
                        GMX_FORCE_ENERGY | (doFreeEnergyPerturbation ? GMX_FORCE_DHDL : 0));
 
+        bool doPairSearch = true;
+        if (pairlistReuse)
+        {
+            doPairSearch = !pairlistReuse->canReusePairlist(state->x, state->box);
+            if (doPairSearch)
+            {
+                ir->rlist = pairlistReuse->startSearch(ir->pbcType, state->x, state->box);
+                fr->rlist = ir->rlist;
+                fr->nbv->changePairlistRadii(ir->rlist, ir->rlist);
+            }
+        }
+
         if (shellfc)
         {
             /* Now is the time to relax the shells */
@@ -554,7 +865,13 @@ void gmx::LegacySimulator::do_rerun()
             do_force(fplog, cr, ms, ir, awh, enforcedRotation, imdSession, pull_work, step, nrnb,
                      wcycle, &top, state->box, state->x.arrayRefWithPadding(), &state->hist,
                      &f.view(), force_vir, mdatoms, enerd, state->lambda, fr, runScheduleWork,
-                     vsite, mu_tot, t, ed, GMX_FORCE_NS | force_flags, ddBalanceRegionHandler);
+                     vsite, mu_tot, t, ed, (doPairSearch ? GMX_FORCE_NS : 0) | force_flags,
+                     ddBalanceRegionHandler);
+        }
+
+        if (pairlistReuse && doPairSearch)
+        {
+            pairlistReuse->finishSearch(state->x, state->box);
         }
 
         /* Now we have the energies and forces corresponding to the
@@ -655,8 +972,14 @@ void gmx::LegacySimulator::do_rerun()
 
         if (MASTER(cr))
         {
-            /* read next frame from input trajectory */
-            isLastStep = !read_next_frame(oenv, status, &rerun_fr);
+            /* read next frame from input trajectory, unless this simulation
+             * has processed all frames of its block */
+            if (splitFramesOverSimulations)
+            {
+                numBlockFramesToRead--;
+            }
+            isLastStep = (splitFramesOverSimulations && numBlockFramesToRead == 0)
+                         || !read_next_frame(oenv, status, &rerun_fr);
         }
 
         if (PAR(cr))
@@ -149,6 +149,7 @@
 #include "gromacs/timing/wallcyclereporting.h"
 #include "gromacs/topology/mtop_util.h"
 #include "gromacs/trajectory/trajectoryframe.h"
+#include "gromacs/utility/alignedallocator.h"
 #include "gromacs/utility/basenetwork.h"
 #include "gromacs/utility/cstringutil.h"
 #include "gromacs/utility/exceptions.h"
@@ -728,7 +729,8 @@ int Mdrunner::mdrunner()
 
     /* CAUTION: threads may be started later on in this function, so
        cr doesn't reflect the final parallel state right now */
-    gmx_mtop_t mtop;
+    /* With thread-MPI, all ranks share the global topology read by the master rank */
+    std::shared_ptr<gmx_mtop_t> globalTopology = std::make_shared<gmx_mtop_t>();
 
     /* TODO: inputrec should tell us whether we use an algorithm, not a file option */
     const bool doEssentialDynamics = opt2bSet("-ei", filenames.size(), filenames.data());
@@ -789,6 +791,12 @@ int Mdrunner::mdrunner()
 
     auto partialDeserializedTpr = std::make_unique<PartialDeserializedTprFile>();
 
+    // With real MPI and many ranks, letting each rank read the
+    // inputrec and topology from the file avoids serializing the
+    // broadcast through the master rank. With thread-MPI the
+    // broadcast is a memory copy, so there is nothing to gain.
+    const bool readTprOnAllRanks = (GMX_LIB_MPI && getenv("GMX_TPR_READ_ON_ALL_RANKS") != nullptr);
+
     if (isSimulationMasterRank)
     {
         // Allocate objects to be initialized by later function calls.
@@ -799,8 +807,9 @@ int Mdrunner::mdrunner()
         /* Read (nearly) all data required for the simulation
          * and keep the partly serialized tpr contents to send to other ranks later
          */
-        applyGlobalSimulationState(*inputHolder_.get(), partialDeserializedTpr.get(),
-                                   globalState.get(), inputrec.get(), &mtop);
+        applyGlobalSimulationState(*inputHolder_.get(),
+                                   readTprOnAllRanks ? nullptr : partialDeserializedTpr.get(),
+                                   globalState.get(), inputrec.get(), globalTopology.get());
     }
 
     /* Check and update the hardware options for internal consistency */
@@ -835,9 +844,9 @@ int Mdrunner::mdrunner()
          * TODO Over-writing the user-supplied value here does
          * prevent any possible subsequent checks from working
          * correctly. */
-        hw_opt.nthreads_tmpi =
-                get_nthreads_mpi(hwinfo, &hw_opt, numDevicesToUse, useGpuForNonbonded, useGpuForPme,
-                                 inputrec.get(), &mtop, mdlog, membedHolder.doMembed());
+        hw_opt.nthreads_tmpi = get_nthreads_mpi(hwinfo, &hw_opt, numDevicesToUse, useGpuForNonbonded,
+                                                useGpuForPme, inputrec.get(), globalTopology.get(),
+                                                mdlog, membedHolder.doMembed());
 
         // Now start the threads for thread MPI.
         spawnThreads(hw_opt.nthreads_tmpi);
@@ -855,19 +864,37 @@ int Mdrunner::mdrunner()
 
     if (PAR(cr))
     {
-        /* now broadcast everything to the non-master nodes/threads: */
         if (!isSimulationMasterRank)
         {
             // Until now, only the master rank has a non-null pointer.
             // On non-master ranks, allocate the object that will receive data in the following call.
             inputrec = std::make_unique<t_inputrec>();
         }
-        init_parallel(cr->mpiDefaultCommunicator, MASTER(cr), inputrec.get(), &mtop,
-                      partialDeserializedTpr.get());
+#if GMX_LIB_MPI
+        if (readTprOnAllRanks)
+        {
+            if (!isSimulationMasterRank)
+            {
+                applyGlobalInputRecordAndTopology(*inputHolder_.get(), inputrec.get(),
+                                                  globalTopology.get());
+            }
+        }
+        else
+#endif
+        {
+            /* now broadcast everything to the non-master nodes/threads: */
+            init_parallel(cr->mpiDefaultCommunicator, MASTER(cr), inputrec.get(), &globalTopology,
+                          partialDeserializedTpr.get());
+        }
     }
     GMX_RELEASE_ASSERT(inputrec != nullptr, "All ranks should have a valid inputrec now");
     partialDeserializedTpr.reset(nullptr);
 
+    // From here on the global topology is only read, which is what
+    // allows thread-MPI ranks to share it. Membrane embedding, which
+    // does modify it, is only supported with a single rank.
+    const gmx_mtop_t& mtop = *globalTopology;
+
     // Now the number of ranks is known to all ranks, and each knows
     // the inputrec read by the master rank. The ranks can now all run
     // the task-deciding functions and will agree on the result
@@ -1391,12 +1418,27 @@ int Mdrunner::mdrunner()
         gmx_check_thread_affinity_set(mdlog, &hw_opt, hwinfo->nthreads_hw_avail, TRUE);
 
         int numThreadsOnThisNode, intraNodeThreadOffset;
-        analyzeThreadsOnThisNode(physicalNodeComm, numThreadsOnThisRank, &numThreadsOnThisNode,
-                                 &intraNodeThreadOffset);
+        int numCacheAlignedThreadsOnThisNode, cacheAlignedThreadOffset;
+        analyzeThreadsOnThisNode(physicalNodeComm, *hwinfo->hardwareTopology, numThreadsOnThisRank,
+                                 &numThreadsOnThisNode, &intraNodeThreadOffset,
+                                 &numCacheAlignedThreadsOnThisNode, &cacheAlignedThreadOffset);
 
         /* Set the CPU affinity */
-        gmx_set_thread_affinity(mdlog, cr, &hw_opt, *hwinfo->hardwareTopology, numThreadsOnThisRank,
-                                numThreadsOnThisNode, intraNodeThreadOffset, nullptr);
+        const bool threadsArePinned = gmx_set_thread_affinity(
+                mdlog, cr, &hw_opt, *hwinfo->hardwareTopology, numThreadsOnThisRank,
+                numThreadsOnThisNode, intraNodeThreadOffset, numCacheAlignedThreadsOnThisNode,
+                cacheAlignedThreadOffset, nullptr);
+
+        /* With pinned threads, first touching the pages of large buffers
+         * with the update threads places them on the NUMA nodes of those
+         * threads. Without pinning we do not know where the threads will
+         * run, so no placement, also not one derived from the hardware
+         * topology, can be expected to help and we leave it to the OS.
+         */
+        if (threadsArePinned)
+        {
+            NumaAwareAllocationPolicy::setNumThreadsForFirstTouch(gmx_omp_nthreads_get(emntUpdate));
+        }
     }
 
     if (mdrunOptions.timingOptions.resetStep > -1)
@@ -1419,8 +1461,9 @@ int Mdrunner::mdrunner()
     }
 
     // Membrane embedding must be initialized before we call init_forcerec()
-    membedHolder.initializeMembed(fplog, filenames.size(), filenames.data(), &mtop, inputrec.get(),
-                                  globalState.get(), cr, &mdrunOptions.checkpointOptions.period);
+    membedHolder.initializeMembed(fplog, filenames.size(), filenames.data(), globalTopology.get(),
+                                  inputrec.get(), globalState.get(), cr,
+                                  &mdrunOptions.checkpointOptions.period);
 
     const bool               thisRankHasPmeGpuTask = gpuTaskAssignments.thisRankHasPmeGpuTask();
     std::unique_ptr<MDAtoms> mdAtoms;
@@ -52,10 +52,23 @@ void applyGlobalSimulationState(const SimulationInput&      simulationInput,
                                 t_inputrec*                 inputRecord,
                                 gmx_mtop_t*                 molecularTopology)
 {
+    if (partialDeserializedTpr == nullptr)
+    {
+        readTpxStateWithoutBroadcast(simulationInput.tprFilename_.c_str(), inputRecord, globalState,
+                                     molecularTopology);
+        return;
+    }
     *partialDeserializedTpr = read_tpx_state(simulationInput.tprFilename_.c_str(), inputRecord,
                                              globalState, molecularTopology);
 }
 
+void applyGlobalInputRecordAndTopology(const SimulationInput& simulationInput,
+                                       t_inputrec*            inputRecord,
+                                       gmx_mtop_t*            molecularTopology)
+{
+    readTprInputrecAndTopology(simulationInput.tprFilename_.c_str(), inputRecord, molecularTopology);
+}
+
 void applyLocalState(const SimulationInput&         simulationInput,
                      t_fileio*                      logfio,
                      const t_commrec*               cr,
@@ -112,11 +112,21 @@ public:
  */
 // TODO: Remove this monolithic detail as member data can be separately cached and managed. (#3374)
 // Note that clients still need tpxio.h for PartialDeserializedTprFile.
+// When partialDeserializedTpr is nullptr, the contents are not prepared
+// for broadcasting to other ranks.
 void applyGlobalSimulationState(const SimulationInput&      simulationInput,
                                 PartialDeserializedTprFile* partialDeserializedTpr,
                                 t_state*                    globalState,
                                 t_inputrec*                 inputrec,
                                 gmx_mtop_t*                 globalTopology);
+/*! \brief Read only the input record and topology, without the state
+ *
+ * Lets any rank set itself up directly from the simulation input,
+ * instead of receiving the data from the master rank.
+ */
+void applyGlobalInputRecordAndTopology(const SimulationInput& simulationInput,
+                                       t_inputrec*            inputrec,
+                                       gmx_mtop_t*            globalTopology);
 // TODO: Implement the following, pending further discussion re #3374.
 std::unique_ptr<t_state> globalSimulationState(const SimulationInput&);
 void                     applyGlobalInputRecord(const SimulationInput&, t_inputrec*);
@@ -305,14 +305,14 @@ class TopologyData
 {
 public:
     //! Build collection from simulation data.
-    TopologyData(gmx_mtop_t* globalTopology, MDAtoms* mdAtoms) :
+    TopologyData(const gmx_mtop_t* globalTopology, MDAtoms* mdAtoms) :
         top_global(globalTopology),
         mdAtoms(mdAtoms)
     {
     }
 
     //! Handle to global simulation topology.
-    gmx_mtop_t* top_global;
+    const gmx_mtop_t* top_global;
     //! Handle to information about MDAtoms.
     MDAtoms* mdAtoms;
 };
@@ -187,6 +187,15 @@ TEST_F(ThreadAffinityTest, PinsWithAutoAndFewerAutoSetThreads)
     helper_.setAffinity(2);
 }
 
+TEST_F(ThreadAffinityTest, FillsPhysicalCoresBeforeSmtSiblings)
+{
+    helper_.setAffinityOption(ThreadAffinity::On);
+    helper_.setTopology(4, 2, 0);
+    helper_.expectInfoMatchingRegex("filling all physical cores before their SMT siblings");
+    helper_.expectAffinitySet({ 0, 1, 2, 3, 4, 5 });
+    helper_.setAffinity(6);
+}
+
 TEST_F(ThreadAffinityTest, HandlesPinningFailureWithOneThreadFailing)
 {
     helper_.setAffinityOption(ThreadAffinity::On);
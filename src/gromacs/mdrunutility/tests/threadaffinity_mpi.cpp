@@ -83,6 +83,28 @@ TEST(ThreadAffinityMultiRankTest, PinsTwoNodes)
     helper.setAffinity(1);
 }
 
+TEST(ThreadAffinityMultiRankTest, AlignsRanksToLastLevelCacheDomains)
+{
+    GMX_MPI_TEST(4);
+    ThreadAffinityTestHelper helper;
+    helper.setAffinityOption(ThreadAffinity::On);
+    helper.setTopology(8, 1, 2);
+    helper.expectInfoMatchingRegex("Pinning 4 threads .* one hardware thread per core");
+    helper.expectInfoMatchingRegex("last-level cache domains of 2 cores");
+    helper.expectAffinitySet(2 * gmx_node_rank());
+    helper.setAffinity(1);
+}
+
+TEST(ThreadAffinityMultiRankTest, PacksRanksWhenCacheDomainsDoNotFit)
+{
+    GMX_MPI_TEST(4);
+    ThreadAffinityTestHelper helper;
+    helper.setAffinityOption(ThreadAffinity::On);
+    helper.setTopology(4, 2, 2);
+    helper.expectAffinitySet(gmx_node_rank());
+    helper.setAffinity(1);
+}
+
 TEST(ThreadAffinityMultiRankTest, DoesNothingWhenDisabled)
 {
     GMX_MPI_TEST(4);
@@ -94,5 +94,28 @@ void ThreadAffinityTestHelper::setLogicalProcessorCount(int logicalProcessorCoun
     hwTop_ = std::make_unique<HardwareTopology>(logicalProcessorCount);
 }
 
+void ThreadAffinityTestHelper::setTopology(int numCores, int hwThreadsPerCore, int coresPerL3Cache)
+{
+    HardwareTopology::Machine machine;
+    machine.logicalProcessorCount = numCores * hwThreadsPerCore;
+    machine.sockets.push_back({ 0, {} });
+    for (int c = 0; c < numCores; c++)
+    {
+        HardwareTopology::Core core = { c, 0, {} };
+        for (int t = 0; t < hwThreadsPerCore; t++)
+        {
+            core.hwThreads.push_back({ c * hwThreadsPerCore + t, c + t * numCores });
+        }
+        machine.sockets[0].cores.push_back(core);
+    }
+    HardwareTopology::SupportLevel supportLevel = HardwareTopology::SupportLevel::Basic;
+    if (coresPerL3Cache > 0)
+    {
+        machine.caches.push_back({ 3, 0, 64, 16, coresPerL3Cache * hwThreadsPerCore });
+        supportLevel = HardwareTopology::SupportLevel::Full;
+    }
+    hwTop_ = std::make_unique<HardwareTopology>(machine, supportLevel);
+}
+
 } // namespace test
 } // namespace gmx
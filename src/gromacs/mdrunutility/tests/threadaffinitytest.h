@@ -95,6 +95,14 @@ public:
 
     void setLogicalProcessorCount(int logicalProcessorCount);
 
+    /*! \brief Sets a single-socket topology with the given number of cores
+     *
+     * Logical processors are numbered round-robin over the cores, as Linux
+     * does, so the SMT siblings of core \c c are \c c + \c k * \p numCores.
+     * With \p coresPerL3Cache > 0, a shared L3 cache is reported.
+     */
+    void setTopology(int numCores, int hwThreadsPerCore, int coresPerL3Cache);
+
     void setTotNumThreadsIsAuto(bool isAuto) { hwOpt_.totNumThreadsIsAuto = isAuto; }
 
     void expectAffinitySet(int core)
@@ -156,11 +164,16 @@ public:
         }
         gmx::PhysicalNodeCommunicator comm(MPI_COMM_WORLD, physicalNodeId_);
         int                           numThreadsOnThisNode, indexWithinNodeOfFirstThreadOnThisRank;
-        analyzeThreadsOnThisNode(comm, numThreadsOnThisRank, &numThreadsOnThisNode,
-                                 &indexWithinNodeOfFirstThreadOnThisRank);
+        int                           numCacheAlignedThreadsOnThisNode;
+        int                           cacheAlignedIndexOfFirstThreadOnThisRank;
+        analyzeThreadsOnThisNode(comm, *hwTop_, numThreadsOnThisRank, &numThreadsOnThisNode,
+                                 &indexWithinNodeOfFirstThreadOnThisRank,
+                                 &numCacheAlignedThreadsOnThisNode,
+                                 &cacheAlignedIndexOfFirstThreadOnThisRank);
         gmx_set_thread_affinity(logHelper_.logger(), cr_, &hwOpt_, *hwTop_, numThreadsOnThisRank,
                                 numThreadsOnThisNode, indexWithinNodeOfFirstThreadOnThisRank,
-                                &affinityAccess_);
+                                numCacheAlignedThreadsOnThisNode,
+                                cacheAlignedIndexOfFirstThreadOnThisRank, &affinityAccess_);
     }
 
 private:
@@ -39,6 +39,7 @@
 
 #include "config.h"
 
+#include <algorithm>
 #include <cerrno>
 #include <cstdio>
 #include <cstring>
@@ -112,6 +113,7 @@ static bool get_thread_affinity_layout(const gmx::MDLogger&         mdlog,
                                        int   pin_offset,
                                        int*  pin_stride,
                                        int** localityOrder,
+                                       bool* fillPhysicalCoresFirst,
                                        bool* issuedWarning)
 {
     int  hwThreads;
@@ -121,6 +123,10 @@ static bool get_thread_affinity_layout(const gmx::MDLogger&         mdlog,
     bool invalidValue;
 
     haveTopology = (hwTop.supportLevel() >= gmx::HardwareTopology::SupportLevel::Basic);
+    /* With a known topology and no user choices for the layout, we order
+     * the hardware threads such that all physical cores are used before
+     * any of their SMT siblings, so we can pin with unit stride. */
+    *fillPhysicalCoresFirst = (haveTopology && *pin_stride == 0 && pin_offset == 0);
 
     if (pin_offset < 0)
     {
@@ -138,13 +144,41 @@ static bool get_thread_affinity_layout(const gmx::MDLogger&         mdlog,
         hwThreadsPerCore = hwTop.machine().sockets[0].cores[0].hwThreads.size();
         snew(*localityOrder, hwThreads);
         int i = 0;
-        for (auto& s : hwTop.machine().sockets)
+        if (*fillPhysicalCoresFirst)
         {
-            for (auto& c : s.cores)
+            size_t maxHwThreadsPerCore = 0;
+            for (auto& s : hwTop.machine().sockets)
             {
-                for (auto& t : c.hwThreads)
+                for (auto& c : s.cores)
                 {
-                    (*localityOrder)[i++] = t.logicalProcessorId;
+                    maxHwThreadsPerCore = std::max(maxHwThreadsPerCore, c.hwThreads.size());
+                }
+            }
+            /* List the first hardware thread of every core, then the second, etc. */
+            for (size_t smtIndex = 0; smtIndex < maxHwThreadsPerCore; smtIndex++)
+            {
+                for (auto& s : hwTop.machine().sockets)
+                {
+                    for (auto& c : s.cores)
+                    {
+                        if (smtIndex < c.hwThreads.size() && i < hwThreads)
+                        {
+                            (*localityOrder)[i++] = c.hwThreads[smtIndex].logicalProcessorId;
+                        }
+                    }
+                }
+            }
+        }
+        else
+        {
+            for (auto& s : hwTop.machine().sockets)
+            {
+                for (auto& c : s.cores)
+                {
+                    for (auto& t : c.hwThreads)
+                    {
+                        (*localityOrder)[i++] = t.logicalProcessorId;
+                    }
                 }
             }
         }
@@ -221,7 +255,12 @@ static bool get_thread_affinity_layout(const gmx::MDLogger&         mdlog,
 
     if (bPickPinStride)
     {
-        if (haveTopology && pin_offset + threads * hwThreadsPerCore <= hwThreads)
+        if (*fillPhysicalCoresFirst)
+        {
+            /* The locality order already lists SMT siblings last */
+            *pin_stride = 1;
+        }
+        else if (haveTopology && pin_offset + threads * hwThreadsPerCore <= hwThreads)
         {
             /* Put one thread on each physical core */
             *pin_stride = hwThreadsPerCore;
@@ -258,7 +297,19 @@ static bool get_thread_affinity_layout(const gmx::MDLogger&         mdlog,
     }
     validLayout = validLayout && !invalidValue;
 
-    if (validLayout)
+    if (validLayout && *fillPhysicalCoresFirst)
+    {
+        const int numCores = hwTop.numberOfCores();
+        GMX_LOG(mdlog.info)
+                .appendTextFormatted(
+                        "Pinning %d threads with an auto-selected layout over %d physical cores,\n"
+                        "%s",
+                        threads, numCores,
+                        threads <= numCores ? "using one hardware thread per core"
+                                            : "filling all physical cores before their SMT "
+                                              "siblings");
+    }
+    else if (validLayout)
     {
         GMX_LOG(mdlog.info)
                 .appendTextFormatted("Pinning threads with a%s logical core stride of %d",
@@ -366,24 +417,71 @@ static bool set_affinity(const t_commrec*            cr,
     return allAffinitiesSet;
 }
 
+/*! \brief Returns the number of physical cores sharing the last-level cache
+ *
+ * Returns 0 when the topology does not report an L3 (or higher) cache
+ * that is shared by more than one core and by fewer than all cores
+ * of the node, since then there are no domains to align ranks to.
+ * Note that we assume that the cores sharing a cache are consecutive
+ * in the topology, which is the case for hwloc.
+ */
+static int coresPerLastLevelCacheDomain(const gmx::HardwareTopology& hwTop)
+{
+    if (hwTop.supportLevel() < gmx::HardwareTopology::SupportLevel::Full
+        || hwTop.machine().caches.empty())
+    {
+        return 0;
+    }
+    // Caches are stored in increasing level order
+    const auto& lastLevelCache = hwTop.machine().caches.back();
+    const int   hwThreadsPerCore = hwTop.machine().sockets[0].cores[0].hwThreads.size();
+    if (lastLevelCache.level < 3 || hwThreadsPerCore == 0)
+    {
+        return 0;
+    }
+    const int coresPerDomain = lastLevelCache.shared / hwThreadsPerCore;
+
+    return (coresPerDomain > 1 && coresPerDomain < hwTop.numberOfCores()) ? coresPerDomain : 0;
+}
+
 void analyzeThreadsOnThisNode(const gmx::PhysicalNodeCommunicator& physicalNodeComm,
+                              const gmx::HardwareTopology&         hwTop,
                               int                                  numThreadsOnThisRank,
                               int*                                 numThreadsOnThisNode,
-                              int*                                 intraNodeThreadOffset)
+                              int*                                 intraNodeThreadOffset,
+                              int*                                 numCacheAlignedThreadsOnThisNode,
+                              int*                                 cacheAlignedThreadOffset)
 {
-    *intraNodeThreadOffset = 0;
-    *numThreadsOnThisNode  = numThreadsOnThisRank;
+    /* Round the thread count of this rank up to whole cache domains,
+     * so that the next rank starts on a fresh domain */
+    const int coresPerDomain = coresPerLastLevelCacheDomain(hwTop);
+    int       numCacheAlignedThreadsOnThisRank = numThreadsOnThisRank;
+    if (coresPerDomain > 0)
+    {
+        numCacheAlignedThreadsOnThisRank =
+                ((numThreadsOnThisRank + coresPerDomain - 1) / coresPerDomain) * coresPerDomain;
+    }
+
+    *intraNodeThreadOffset            = 0;
+    *numThreadsOnThisNode             = numThreadsOnThisRank;
+    *cacheAlignedThreadOffset         = 0;
+    *numCacheAlignedThreadsOnThisNode = numCacheAlignedThreadsOnThisRank;
 #if GMX_MPI
     if (physicalNodeComm.size_ > 1)
     {
         /* We need to determine a scan of the thread counts in this
          * compute node. */
-        MPI_Scan(&numThreadsOnThisRank, intraNodeThreadOffset, 1, MPI_INT, MPI_SUM, physicalNodeComm.comm_);
+        int counts[2] = { numThreadsOnThisRank, numCacheAlignedThreadsOnThisRank };
+        int scan[2];
+        int sum[2];
+        MPI_Scan(counts, scan, 2, MPI_INT, MPI_SUM, physicalNodeComm.comm_);
         /* MPI_Scan is inclusive, but here we need exclusive */
-        *intraNodeThreadOffset -= numThreadsOnThisRank;
+        *intraNodeThreadOffset    = scan[0] - counts[0];
+        *cacheAlignedThreadOffset = scan[1] - counts[1];
         /* Get the total number of threads on this physical node */
-        MPI_Allreduce(&numThreadsOnThisRank, numThreadsOnThisNode, 1, MPI_INT, MPI_SUM,
-                      physicalNodeComm.comm_);
+        MPI_Allreduce(counts, sum, 2, MPI_INT, MPI_SUM, physicalNodeComm.comm_);
+        *numThreadsOnThisNode             = sum[0];
+        *numCacheAlignedThreadsOnThisNode = sum[1];
     }
 #else
     GMX_UNUSED_VALUE(physicalNodeComm);
@@ -399,13 +497,15 @@ void analyzeThreadsOnThisNode(const gmx::PhysicalNodeCommunicator& physicalNodeC
    Thus it is important that GROMACS sets the affinity internally
    if only PME is using threads.
  */
-void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
+bool gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
                              const t_commrec*             cr,
                              const gmx_hw_opt_t*          hw_opt,
                              const gmx::HardwareTopology& hwTop,
                              int                          numThreadsOnThisRank,
                              int                          numThreadsOnThisNode,
                              int                          intraNodeThreadOffset,
+                             int                          numCacheAlignedThreadsOnThisNode,
+                             int                          cacheAlignedThreadOffset,
                              gmx::IThreadAffinityAccess*  affinityAccess)
 {
     int* localityOrder = nullptr;
@@ -413,7 +513,7 @@ void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
     if (hw_opt->threadAffinity == ThreadAffinity::Off)
     {
         /* Nothing to do */
-        return;
+        return false;
     }
 
     if (affinityAccess == nullptr)
@@ -434,7 +534,7 @@ void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
                 .asParagraph()
                 .appendText("NOTE: Cannot set thread affinities on the current platform.");
 #endif /* __APPLE__ */
-        return;
+        return false;
     }
 
     int offset              = hw_opt->core_pinning_offset;
@@ -446,16 +546,35 @@ void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
 
     bool affinityIsAutoAndNumThreadsIsNotAuto =
             (hw_opt->threadAffinity == ThreadAffinity::Auto && !hw_opt->totNumThreadsIsAuto);
+    bool fillPhysicalCoresFirst;
     bool issuedWarning;
     bool validLayout = get_thread_affinity_layout(
             mdlog, cr, hwTop, numThreadsOnThisNode, affinityIsAutoAndNumThreadsIsNotAuto, offset,
-            &core_pinning_stride, &localityOrder, &issuedWarning);
+            &core_pinning_stride, &localityOrder, &fillPhysicalCoresFirst, &issuedWarning);
     const gmx::sfree_guard localityOrderGuard(localityOrder);
 
+    /* When every rank can start on its own last-level cache domain without
+     * sharing physical cores, do so. This keeps the thread team of a rank,
+     * and in particular that of a PME-only rank, within as few domains as
+     * possible. The total is the same on all ranks of a node, so all ranks
+     * make the same choice. */
+    int firstThreadIndex = intraNodeThreadOffset;
+    if (validLayout && fillPhysicalCoresFirst
+        && numCacheAlignedThreadsOnThisNode != numThreadsOnThisNode
+        && numCacheAlignedThreadsOnThisNode <= hwTop.numberOfCores())
+    {
+        firstThreadIndex = cacheAlignedThreadOffset;
+        GMX_LOG(mdlog.info)
+                .appendTextFormatted(
+                        "Aligning the threads of each rank to last-level cache domains of %d "
+                        "cores",
+                        coresPerLastLevelCacheDomain(hwTop));
+    }
+
     bool allAffinitiesSet;
     if (validLayout)
     {
-        allAffinitiesSet = set_affinity(cr, numThreadsOnThisRank, intraNodeThreadOffset, offset,
+        allAffinitiesSet = set_affinity(cr, numThreadsOnThisRank, firstThreadIndex, offset,
                                         core_pinning_stride, localityOrder, affinityAccess);
     }
     else
@@ -467,6 +586,8 @@ void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
     {
         GMX_LOG(mdlog.warning).asParagraph().appendText("NOTE: Thread affinity was not set.");
     }
+
+    return allAffinitiesSet;
 }
 
 /* Detects and returns whether we have the default affinity mask
@@ -71,11 +71,31 @@ protected:
 } // namespace gmx
 
 /*! \brief Communicates within physical nodes to discover the
- * distribution of threads over ranks. */
+ * distribution of threads over ranks.
+ *
+ * Besides the plain thread counts, this also computes the layout in which
+ * the thread team of every rank starts at the boundary of a last-level
+ * cache domain, for use by gmx_set_thread_affinity(). When the topology
+ * does not report such domains, the aligned values equal the plain ones.
+ *
+ * \param[in]  physicalNodeComm                  Communicator over the ranks of this node.
+ * \param[in]  hwTop                             Detected hardware topology.
+ * \param[in]  numThreadsOnThisRank              The number of threads on this rank.
+ * \param[out] numThreadsOnThisNode              The number of threads on all ranks of this node.
+ * \param[out] intraNodeThreadOffset             The index of the first thread of this rank
+ *   in the set of all the threads of all MPI ranks within a node (ordered by MPI rank ID).
+ * \param[out] numCacheAlignedThreadsOnThisNode  The number of physical cores covered when
+ *   the threads of every rank are rounded up to whole last-level cache domains.
+ * \param[out] cacheAlignedThreadOffset          As \p intraNodeThreadOffset, but in the
+ *   layout rounded up to whole last-level cache domains.
+ */
 void analyzeThreadsOnThisNode(const gmx::PhysicalNodeCommunicator& physicalNodeComm,
+                              const gmx::HardwareTopology&         hwTop,
                               int                                  numThreadsOnThisRank,
                               int*                                 numThreadsOnThisNode,
-                              int*                                 intraNodeThreadOffset);
+                              int*                                 intraNodeThreadOffset,
+                              int*                                 numCacheAlignedThreadsOnThisNode,
+                              int*                                 cacheAlignedThreadOffset);
 
 /*! \brief
  * Sets the thread affinity using the requested setting stored in hw_opt.
@@ -90,15 +110,23 @@ void analyzeThreadsOnThisNode(const gmx::PhysicalNodeCommunicator& physicalNodeC
  * \param[in]  numThreadsOnThisNode   The number of threads on all ranks of this node.
  * \param[in]  intraNodeThreadOffset  The index of the first hardware thread of this rank
  *   in the set of all the threads of all MPI ranks within a node (ordered by MPI rank ID).
+ * \param[in]  numCacheAlignedThreadsOnThisNode  The number of physical cores needed to start
+ *   the threads of every rank of this node at a last-level cache domain boundary.
+ * \param[in]  cacheAlignedThreadOffset          The index of the first core of this rank
+ *   in that cache-domain aligned layout.
  * \param[in]  affinityAccess         Interface for low-level access to affinity details.
+ *
+ * \returns Whether the affinity was set for all threads of this rank.
  */
-void gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
+bool gmx_set_thread_affinity(const gmx::MDLogger&         mdlog,
                              const t_commrec*             cr,
                              const gmx_hw_opt_t*          hw_opt,
                              const gmx::HardwareTopology& hwTop,
                              int                          numThreadsOnThisRank,
                              int                          numThreadsOnThisNode,
                              int                          intraNodeThreadOffset,
+                             int                          numCacheAlignedThreadsOnThisNode,
+                             int                          cacheAlignedThreadOffset,
                              gmx::IThreadAffinityAccess*  affinityAccess);
 
 /*! \brief
@@ -42,6 +42,7 @@
 #ifndef GMX_MODULARSIMULATOR_CHECKPOINTDATA_H
 #define GMX_MODULARSIMULATOR_CHECKPOINTDATA_H
 
+#include <algorithm>
 #include <optional>
 
 #include "gromacs/math/vectypes.h"
@@ -107,6 +108,20 @@ struct IsSerializableType
                               || std::is_same<T, float>::value || std::is_same<T, double>::value;
 };
 
+/*! \internal
+ * \ingroup module_modularsimulator
+ * \brief Struct allowing to check if arrays of a type are stored as typed arrays
+ *
+ * Numeric arrays are stored as a single contiguous KeyValueTree value,
+ * while arrays of other types are stored as one value per element.
+ */
+template<typename T>
+struct IsTypedArrayType
+{
+    static bool const value = std::is_same<T, int>::value || std::is_same<T, int64_t>::value
+                              || std::is_same<T, float>::value || std::is_same<T, double>::value;
+};
+
 /*! \internal
  * \ingroup module_modularsimulator
  * \brief Struct allowing to check if enum has a serializable underlying type
@@ -178,6 +193,10 @@ public:
      * int64_t, float, double, and gmx::RVec. Type compatibility is checked
      * at compile time.
      *
+     * Arrays of int, int64_t, float, double and gmx::RVec are stored as
+     * a single contiguous typed array. Reading also accepts the
+     * per-element arrays written by earlier versions.
+     *
      * \tparam operation  Whether we are reading or writing
      * \tparam T          The type of values stored in the ArrayRef
      * \param key         The key to [read|write] the ArrayRef [from|to]
@@ -431,12 +450,24 @@ inline std::enable_if_t<IsSerializableType<T>::value, void>
 ReadCheckpointData::arrayRef(const std::string& key, ArrayRef<T> values) const
 {
     GMX_RELEASE_ASSERT(inputTree_, "No input checkpoint data available.");
-    GMX_RELEASE_ASSERT(values.size() >= (*inputTree_)[key].asArray().values().size(),
+    const auto& storedValue = (*inputTree_)[key];
+    if constexpr (IsTypedArrayType<T>::value)
+    {
+        if (storedValue.isTypedArray())
+        {
+            const auto storedValues = storedValue.asTypedArray<T>();
+            GMX_RELEASE_ASSERT(values.size() >= storedValues.size(),
+                               "Read vector does not fit in passed ArrayRef.");
+            std::copy(storedValues.begin(), storedValues.end(), values.begin());
+            return;
+        }
+    }
+    GMX_RELEASE_ASSERT(values.size() >= storedValue.asArray().values().size(),
                        "Read vector does not fit in passed ArrayRef.");
     auto outputIt  = values.begin();
-    auto inputIt   = (*inputTree_)[key].asArray().values().begin();
+    auto inputIt   = storedValue.asArray().values().begin();
     auto outputEnd = values.end();
-    auto inputEnd  = (*inputTree_)[key].asArray().values().end();
+    auto inputEnd  = storedValue.asArray().values().end();
     for (; outputIt != outputEnd && inputIt != inputEnd; outputIt++, inputIt++)
     {
         *outputIt = inputIt->cast<T>();
@@ -448,21 +479,41 @@ inline std::enable_if_t<IsSerializableType<T>::value, void>
 WriteCheckpointData::arrayRef(const std::string& key, ArrayRef<const T> values)
 {
     GMX_RELEASE_ASSERT(outputTreeBuilder_, "No output checkpoint data available.");
-    auto builder = outputTreeBuilder_->addUniformArray<T>(key);
-    for (const auto& value : values)
+    if constexpr (IsTypedArrayType<T>::value)
+    {
+        outputTreeBuilder_->addTypedArray(key, values);
+    }
+    else
     {
-        builder.addValue(value);
+        auto builder = outputTreeBuilder_->addUniformArray<T>(key);
+        for (const auto& value : values)
+        {
+            builder.addValue(value);
+        }
     }
 }
 
 inline void ReadCheckpointData::arrayRef(const std::string& key, ArrayRef<RVec> values) const
 {
-    GMX_RELEASE_ASSERT(values.size() >= (*inputTree_)[key].asArray().values().size(),
+    const auto& storedValue = (*inputTree_)[key];
+    if (storedValue.isTypedArray())
+    {
+        const auto storedValues = storedValue.asTypedArray<real>();
+        GMX_RELEASE_ASSERT(values.size() * DIM >= storedValues.size(),
+                           "Read vector does not fit in passed ArrayRef.");
+        for (size_t i = 0; i < storedValues.size() / DIM; i++)
+        {
+            values[i] = { storedValues[i * DIM + XX], storedValues[i * DIM + YY],
+                          storedValues[i * DIM + ZZ] };
+        }
+        return;
+    }
+    GMX_RELEASE_ASSERT(values.size() >= storedValue.asArray().values().size(),
                        "Read vector does not fit in passed ArrayRef.");
     auto outputIt  = values.begin();
-    auto inputIt   = (*inputTree_)[key].asArray().values().begin();
+    auto inputIt   = storedValue.asArray().values().begin();
     auto outputEnd = values.end();
-    auto inputEnd  = (*inputTree_)[key].asArray().values().end();
+    auto inputEnd  = storedValue.asArray().values().end();
     for (; outputIt != outputEnd && inputIt != inputEnd; outputIt++, inputIt++)
     {
         auto storedRVec = inputIt->asObject()["RVec"].asArray().values();
@@ -473,12 +524,9 @@ inline void ReadCheckpointData::arrayRef(const std::string& key, ArrayRef<RVec>
 
 inline void WriteCheckpointData::arrayRef(const std::string& key, ArrayRef<const RVec> values)
 {
-    auto builder = outputTreeBuilder_->addObjectArray(key);
-    for (const auto& value : values)
-    {
-        auto subbuilder = builder.addObject();
-        subbuilder.addUniformArray("RVec", { value[XX], value[YY], value[ZZ] });
-    }
+    const real* flattenedValues = reinterpret_cast<const real*>(values.data());
+    outputTreeBuilder_->addTypedArray(key,
+                                      constArrayRefFromArray(flattenedValues, values.size() * DIM));
 }
 
 inline void ReadCheckpointData::tensor(const std::string& key, ::tensor values) const
@@ -52,27 +52,42 @@ using namespace gmx;
 class ForceProviders::Impl
 {
 public:
-    std::vector<IForceProvider*> providers_;
+    EnumerationArray<ForceProviderTimeScale, std::vector<IForceProvider*>> providers_;
 };
 
 ForceProviders::ForceProviders() : impl_(new Impl) {}
 
 ForceProviders::~ForceProviders() {}
 
-void ForceProviders::addForceProvider(gmx::IForceProvider* provider)
+void ForceProviders::addForceProvider(gmx::IForceProvider*   provider,
+                                      ForceProviderTimeScale timeScale)
 {
-    impl_->providers_.push_back(provider);
+    impl_->providers_[timeScale].push_back(provider);
 }
 
 bool ForceProviders::hasForceProvider() const
 {
-    return !impl_->providers_.empty();
+    return hasForceProvider(ForceProviderTimeScale::Fast)
+           || hasForceProvider(ForceProviderTimeScale::Slow);
+}
+
+bool ForceProviders::hasForceProvider(ForceProviderTimeScale timeScale) const
+{
+    return !impl_->providers_[timeScale].empty();
 }
 
 void ForceProviders::calculateForces(const ForceProviderInput& forceProviderInput,
                                      ForceProviderOutput*      forceProviderOutput) const
 {
-    for (auto provider : impl_->providers_)
+    calculateForces(forceProviderInput, forceProviderOutput, ForceProviderTimeScale::Fast);
+    calculateForces(forceProviderInput, forceProviderOutput, ForceProviderTimeScale::Slow);
+}
+
+void ForceProviders::calculateForces(const ForceProviderInput& forceProviderInput,
+                                     ForceProviderOutput*      forceProviderOutput,
+                                     ForceProviderTimeScale    timeScale) const
+{
+    for (auto provider : impl_->providers_[timeScale])
     {
         provider->calculateForces(forceProviderInput, forceProviderOutput);
     }
@@ -49,6 +49,7 @@
 #include "gromacs/math/vec.h"
 #include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/classhelpers.h"
+#include "gromacs/utility/enumerationhelpers.h"
 #include "gromacs/utility/gmxassert.h"
 
 struct gmx_enerdata_t;
@@ -173,6 +174,19 @@ protected:
     ~IForceProvider() {}
 };
 
+/*! \brief Time scale on which the forces of a gmx::IForceProvider vary
+ *
+ * With multiple time stepping, the forces of slowly varying providers are only computed
+ * every mts-level2-factor steps and integrated with the impulse scaled by that factor.
+ * Without multiple time stepping, all providers are evaluated every step.
+ */
+enum class ForceProviderTimeScale : int
+{
+    Fast, //!< Evaluated every step
+    Slow, //!< Evaluated at the slow multiple time-stepping level
+    Count //!< The number of time scales
+};
+
 /*! \libinternal \brief
  * Evaluates forces from a collection of gmx::IForceProvider.
  *
@@ -187,16 +201,28 @@ public:
 
     /*! \brief
      * Adds a provider.
+     *
+     * \param[in] provider   The force provider
+     * \param[in] timeScale  The time scale on which the forces of \p provider vary
      */
-    void addForceProvider(gmx::IForceProvider* provider);
+    void addForceProvider(gmx::IForceProvider*   provider,
+                          ForceProviderTimeScale timeScale = ForceProviderTimeScale::Fast);
 
     //! Whether there are modules added.
     bool hasForceProvider() const;
 
+    //! Whether there are modules added with time scale \p timeScale.
+    bool hasForceProvider(ForceProviderTimeScale timeScale) const;
+
     //! Computes forces.
     void calculateForces(const gmx::ForceProviderInput& forceProviderInput,
                          gmx::ForceProviderOutput*      forceProviderOutput) const;
 
+    //! Computes forces of the modules added with time scale \p timeScale.
+    void calculateForces(const gmx::ForceProviderInput& forceProviderInput,
+                         gmx::ForceProviderOutput*      forceProviderOutput,
+                         ForceProviderTimeScale         timeScale) const;
+
 private:
     class Impl;
 
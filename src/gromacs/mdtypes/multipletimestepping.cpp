@@ -36,7 +36,9 @@
 
 #include "multipletimestepping.h"
 
+#include "gromacs/mdtypes/awh_params.h"
 #include "gromacs/mdtypes/inputrec.h"
+#include "gromacs/mdtypes/pull_params.h"
 #include "gromacs/utility/gmxassert.h"
 
 namespace gmx
@@ -56,6 +58,13 @@ int nonbondedMtsFactor(const t_inputrec& ir)
     }
 }
 
+int forceGroupMtsLevel(ArrayRef<const MtsLevel> mtsLevels, const MtsForceGroups mtsForceGroup)
+{
+    GMX_ASSERT(mtsLevels.empty() || mtsLevels.size() == 2, "Only 0 or 2 MTS levels are supported");
+
+    return (mtsLevels.empty() || mtsLevels[0].forceGroups[static_cast<int>(mtsForceGroup)]) ? 0 : 1;
+}
+
 void assertMtsRequirements(const t_inputrec& ir)
 {
     if (!ir.useMts)
@@ -84,6 +93,15 @@ void assertMtsRequirements(const t_inputrec& ir)
                            "nstpcouple should be a multiple of mtsFactor");
         GMX_RELEASE_ASSERT(ir.efep == efepNO || ir.fepvals->nstdhdl % mtsFactor == 0,
                            "nstdhdl should be a multiple of mtsFactor");
+        if (ir.bPull && mtsLevel.forceGroups[static_cast<int>(MtsForceGroups::Pull)])
+        {
+            GMX_RELEASE_ASSERT(ir.pull->nstxout % mtsFactor == 0,
+                               "pull-nstxout should be a multiple of mtsFactor");
+            GMX_RELEASE_ASSERT(ir.pull->nstfout % mtsFactor == 0,
+                               "pull-nstfout should be a multiple of mtsFactor");
+            GMX_RELEASE_ASSERT(!ir.bDoAwh || ir.awhParams->nstSampleCoord % mtsFactor == 0,
+                               "awh-nstsample should be a multiple of mtsFactor");
+        }
         if (ir.mtsLevels.back().forceGroups[static_cast<int>(gmx::MtsForceGroups::Nonbonded)])
         {
             GMX_RELEASE_ASSERT(ir.nstlist % ir.mtsLevels.back().stepFactor == 0,
@@ -37,6 +37,7 @@
 
 #include <bitset>
 
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/enumerationhelpers.h"
 
 struct t_inputrec;
@@ -52,11 +53,12 @@ enum class MtsForceGroups : int
     Pair,               //!< Bonded pair interactions
     Dihedral,           //!< Dihedrals, including cmap (not restraints)
     Angle,              //! Bonded angle potentials (not restraints)
+    Pull,               //! COM pulling potentials, including AWH biases acting through them
     Count               //! The number of groups above
 };
 
 static const gmx::EnumerationArray<MtsForceGroups, std::string> mtsForceGroupNames = {
-    "longrange-nonbonded", "nonbonded", "pair", "dihedral", "angle"
+    "longrange-nonbonded", "nonbonded", "pair", "dihedral", "angle", "pull"
 };
 
 //! Setting for a single level for multiple time step integration
@@ -74,6 +76,13 @@ struct MtsLevel
  */
 int nonbondedMtsFactor(const t_inputrec& ir);
 
+/*! \brief Returns the MTS level at which \p mtsForceGroup is computed
+ *
+ * \param[in] mtsLevels      The MTS levels, empty when multiple time-stepping is not used
+ * \param[in] mtsForceGroup  The force group to return the level for
+ */
+int forceGroupMtsLevel(ArrayRef<const MtsLevel> mtsLevels, MtsForceGroups mtsForceGroup);
+
 //! (Release) Asserts that all multiple time-stepping requirements on \p ir are fulfilled
 void assertMtsRequirements(const t_inputrec& ir);
 
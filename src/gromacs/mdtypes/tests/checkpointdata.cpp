@@ -489,5 +489,32 @@ TEST_F(CheckpointDataTest, MultiDataTest)
     }
 }
 
+TEST(CheckpointDataRVecTest, RoundTripsAsTypedArray)
+{
+    const std::vector<RVec> values = { { 1, 2, 3 }, { -4.5, 5.25, 1e-3 }, { 0, -7, 8e4 } };
+
+    WriteCheckpointDataHolder writeCheckpointDataHolder;
+    {
+        auto writeCheckpointData = writeCheckpointDataHolder.checkpointData("test");
+        writeCheckpointData.arrayRef("rvecs", makeConstArrayRef(values));
+    }
+    InMemorySerializer serializer;
+    writeCheckpointDataHolder.serialize(&serializer);
+    std::vector<char> buffer = serializer.finishAndGetBuffer();
+
+    InMemoryDeserializer     deserializer(buffer, false);
+    ReadCheckpointDataHolder readCheckpointDataHolder;
+    readCheckpointDataHolder.deserialize(&deserializer);
+    std::vector<RVec> result(values.size());
+    readCheckpointDataHolder.checkpointData("test").arrayRef("rvecs", makeArrayRef(result));
+    for (size_t i = 0; i < values.size(); i++)
+    {
+        for (int d = 0; d < DIM; d++)
+        {
+            EXPECT_EQ(values[i][d], result[i][d]);
+        }
+    }
+}
+
 } // namespace
 } // namespace gmx::test
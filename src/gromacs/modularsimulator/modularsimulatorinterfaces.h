@@ -476,6 +476,13 @@ struct PropagatorBarostatConnection
     std::function<ArrayRef<rvec>()> getViewOnPRScalingMatrix;
     //! Function variable for callback.
     std::function<PropagatorCallback()> getPRScalingCallback;
+    /*! \brief Function variable enabling position scaling in the propagator
+     *
+     * Returns a view on the position scaling matrix, which the propagator applies to the
+     * updated positions on Parrinello-Rahman scaling steps. Empty if the propagator does
+     * not update positions.
+     */
+    std::function<ArrayRef<rvec>()> enablePositionScaling;
 };
 
 //! /}
@@ -47,8 +47,10 @@
 #include "gromacs/math/units.h"
 #include "gromacs/math/vec.h"
 #include "gromacs/mdlib/coupling.h"
+#include "gromacs/mdlib/gmx_omp_nthreads.h"
 #include "gromacs/mdlib/mdatoms.h"
 #include "gromacs/mdlib/stat.h"
+#include "gromacs/mdlib/update.h"
 #include "gromacs/mdtypes/checkpointdata.h"
 #include "gromacs/mdtypes/commrec.h"
 #include "gromacs/mdtypes/inputrec.h"
@@ -71,11 +73,13 @@ ParrinelloRahmanBarostat::ParrinelloRahmanBarostat(int                  nstpcoup
                                                    EnergyData*          energyData,
                                                    FILE*                fplog,
                                                    const t_inputrec*    inputrec,
-                                                   const MDAtoms*       mdAtoms) :
+                                                   const MDAtoms*       mdAtoms,
+                                                   bool canScalePositionsInPropagator) :
     nstpcouple_(nstpcouple),
     offset_(offset),
     couplingTimeStep_(couplingTimeStep),
     initStep_(initStep),
+    canScalePositionsInPropagator_(canScalePositionsInPropagator),
     mu_{ { 0 } },
     boxRel_{ { 0 } },
     boxVelocity_{ { 0 } },
@@ -92,6 +96,10 @@ void ParrinelloRahmanBarostat::connectWithPropagator(const PropagatorBarostatCon
 {
     scalingTensor_      = connectionData.getViewOnPRScalingMatrix();
     propagatorCallback_ = connectionData.getPRScalingCallback();
+    if (canScalePositionsInPropagator_ && connectionData.enablePositionScaling)
+    {
+        positionScalingMatrix_ = connectionData.enablePositionScaling();
+    }
 }
 
 void ParrinelloRahmanBarostat::scheduleTask(Step step,
@@ -120,6 +128,10 @@ void ParrinelloRahmanBarostat::integrateBoxVelocityEquations(Step step)
                             box, boxRel_, boxVelocity_, scalingTensor_.data(), mu_, false);
     // multiply matrix by the coupling time step to avoid having the propagator needing to know about that
     msmul(scalingTensor_.data(), couplingTimeStep_, scalingTensor_.data());
+    if (!positionScalingMatrix_.empty())
+    {
+        copy_mat(mu_, positionScalingMatrix_.data());
+    }
 }
 
 void ParrinelloRahmanBarostat::scaleBoxAndPositions()
@@ -135,13 +147,31 @@ void ParrinelloRahmanBarostat::scaleBoxAndPositions()
     }
     preserve_box_shape(inputrec_, boxRel_, box);
 
+    if (!positionScalingMatrix_.empty())
+    {
+        // The propagator has scaled the coordinates while updating them
+        return;
+    }
+
     // Scale the coordinates
-    const int start  = 0;
+    const int nth    = gmx_omp_nthreads_get(emntUpdate);
     const int homenr = mdAtoms_->mdatoms()->homenr;
     auto      x      = as_rvec_array(statePropagatorData_->positionsView().paddedArrayRef().data());
-    for (int n = start; n < start + homenr; n++)
+#pragma omp parallel for num_threads(nth) schedule(static) default(none) shared(x) \
+        firstprivate(nth, homenr)
+    for (int th = 0; th < nth; th++)
     {
-        tmvmul_ur0(mu_, x[n], x[n]);
+        try
+        {
+            int start_th, end_th;
+            getThreadAtomRange(nth, th, homenr, &start_th, &end_th);
+
+            for (int n = start_th; n < end_th; n++)
+            {
+                tmvmul_ur0(mu_, x[n], x[n]);
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
     }
 }
 
@@ -179,6 +209,10 @@ void ParrinelloRahmanBarostat::elementSetup()
                                 boxRel_, boxVelocity_, scalingTensor_.data(), mu_, true);
         // multiply matrix by the coupling time step to avoid having the propagator needing to know about that
         msmul(scalingTensor_.data(), couplingTimeStep_, scalingTensor_.data());
+        if (!positionScalingMatrix_.empty())
+        {
+            copy_mat(mu_, positionScalingMatrix_.data());
+        }
 
         propagatorCallback_(initStep_);
     }
@@ -284,11 +318,18 @@ ISimulatorElement* ParrinelloRahmanBarostat::getElementPointerImpl(
         GlobalCommunicationHelper gmx_unused* globalCommunicationHelper,
         int                                   offset)
 {
+    // Constraints and angular COM removal act on the positions between the propagator
+    // and the barostat, so the propagator can only scale the positions without them
+    const bool canScalePositionsInPropagator =
+            legacySimulatorData->constr == nullptr
+            && (legacySimulatorData->inputrec->comm_mode == ecmNO
+                || legacySimulatorData->inputrec->comm_mode == ecmLINEAR);
     auto* element  = builderHelper->storeElement(std::make_unique<ParrinelloRahmanBarostat>(
             legacySimulatorData->inputrec->nstpcouple, offset,
             legacySimulatorData->inputrec->delta_t * legacySimulatorData->inputrec->nstpcouple,
             legacySimulatorData->inputrec->init_step, statePropagatorData, energyData,
-            legacySimulatorData->fplog, legacySimulatorData->inputrec, legacySimulatorData->mdAtoms));
+            legacySimulatorData->fplog, legacySimulatorData->inputrec, legacySimulatorData->mdAtoms,
+            canScalePositionsInPropagator));
     auto* barostat = static_cast<ParrinelloRahmanBarostat*>(element);
     builderHelper->registerBarostat([barostat](const PropagatorBarostatConnection& connection) {
         barostat->connectWithPropagator(connection);
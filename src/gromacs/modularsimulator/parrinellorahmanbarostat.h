@@ -69,6 +69,10 @@ class StatePropagatorData;
  *   * takes a callback to the propagator to update the velocity
  *     scaling factor, and
  *   * scales the box and the positions of the system.
+ *
+ * If no element between the propagator and the barostat depends on the
+ * positions, the position scaling is handed over to a propagator updating
+ * the positions, which applies it in the same pass over the atoms.
  */
 class ParrinelloRahmanBarostat final : public ISimulatorElement, public ICheckpointHelperClient
 {
@@ -82,7 +86,8 @@ public:
                              EnergyData*          energyData,
                              FILE*                fplog,
                              const t_inputrec*    inputrec,
-                             const MDAtoms*       mdAtoms);
+                             const MDAtoms*       mdAtoms,
+                             bool                 canScalePositionsInPropagator);
 
     /*! \brief Register run function for step / time
      *
@@ -146,6 +151,10 @@ private:
     ArrayRef<rvec> scalingTensor_;
     //! Callback to let propagator know that we updated lambda
     PropagatorCallback propagatorCallback_;
+    //! Whether the position scaling may be handed over to the propagator
+    const bool canScalePositionsInPropagator_;
+    //! View on the position scaling matrix (owned by the propagator, empty if we scale ourselves)
+    ArrayRef<rvec> positionScalingMatrix_;
 
     //! Relative change in box before - after barostatting
     matrix mu_;
@@ -249,13 +249,17 @@ void Propagator<IntegrationStep::LeapFrog>::run()
     const bool isFullScalingMatrixDiagonal =
             diagonalizePRMatrix<parrinelloRahmanVelocityScaling>(matrixPR_, diagPR_);
 
+    // Positions are scaled in the same pass if the barostat handed that over to us
+    const bool doPositionScaling = doPositionScaling_;
+
     const int nth    = gmx_omp_nthreads_get(emntUpdate);
     const int homenr = mdAtoms_->mdatoms()->homenr;
 
 // const variables could be shared, but gcc-8 & gcc-9 don't agree how to write that...
 // https://www.gnu.org/software/gcc/gcc-9/porting_to.html -> OpenMP data sharing
-#pragma omp parallel for num_threads(nth) schedule(static) default(none) shared( \
-        x, xp, v, f, invMassPerDim) firstprivate(nth, homenr, lambda, isFullScalingMatrixDiagonal)
+#pragma omp parallel for num_threads(nth) schedule(static) default(none) \
+        shared(x, xp, v, f, invMassPerDim)                               \
+                firstprivate(nth, homenr, lambda, isFullScalingMatrixDiagonal, doPositionScaling)
     for (int th = 0; th < nth; th++)
     {
         try
@@ -284,6 +288,11 @@ void Propagator<IntegrationStep::LeapFrog>::run()
                             invMassPerDim, v, f, diagPR_, matrixPR_);
                 }
                 updatePositions(a, timestep_, x, xp, v);
+                if (parrinelloRahmanVelocityScaling != ParrinelloRahmanVelocityScaling::No
+                    && doPositionScaling)
+                {
+                    tmvmul_ur0(matrixPositionScaling_, xp[a], xp[a]);
+                }
             }
         }
         GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
@@ -365,6 +374,8 @@ Propagator<algorithm>::Propagator(double               timestep,
     diagPR_{ 0 },
     matrixPR_{ { 0 } },
     scalingStepPR_(-1),
+    doPositionScaling_(false),
+    matrixPositionScaling_{ { 0 } },
     mdAtoms_(mdAtoms),
     wcycle_(wcycle)
 {
@@ -488,6 +499,17 @@ PropagatorCallback Propagator<algorithm>::prScalingCallback()
     return [this](Step step) { scalingStepPR_ = step; };
 }
 
+template<IntegrationStep algorithm>
+ArrayRef<rvec> Propagator<algorithm>::enablePositionScaling()
+{
+    GMX_RELEASE_ASSERT(algorithm == IntegrationStep::LeapFrog,
+                       "Position scaling is only implemented for IntegrationStep::LeapFrog.");
+
+    doPositionScaling_ = true;
+    clear_mat(matrixPositionScaling_);
+    return ArrayRef<rvec>(matrixPositionScaling_);
+}
+
 template<IntegrationStep algorithm>
 ISimulatorElement* Propagator<algorithm>::getElementPointerImpl(
         LegacySimulatorData*                    legacySimulatorData,
@@ -513,9 +535,17 @@ ISimulatorElement* Propagator<algorithm>::getElementPointerImpl(
     if (registerWithBarostat == RegisterWithBarostat::True)
     {
         auto* propagator = static_cast<Propagator<algorithm>*>(element);
+        // Only the leap-frog propagator updates the positions after the PR velocity scaling,
+        // so it is the only one which can take over the position scaling of the barostat
+        std::function<ArrayRef<rvec>()> enablePositionScaling;
+        if (algorithm == IntegrationStep::LeapFrog)
+        {
+            enablePositionScaling = [propagator]() { return propagator->enablePositionScaling(); };
+        }
         builderHelper->registerWithBarostat(
                 { [propagator]() { return propagator->viewOnPRScalingMatrix(); },
-                  [propagator]() { return propagator->prScalingCallback(); } });
+                  [propagator]() { return propagator->prScalingCallback(); },
+                  std::move(enablePositionScaling) });
     }
     return element;
 }
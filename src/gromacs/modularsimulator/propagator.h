@@ -165,6 +165,8 @@ public:
     ArrayRef<rvec> viewOnPRScalingMatrix();
     //! Get PR scaling callback
     PropagatorCallback prScalingCallback();
+    //! Enable position scaling on PR steps and get view on the position scaling matrix
+    ArrayRef<rvec> enablePositionScaling();
 
     /*! \brief Factory method implementation
      *
@@ -217,6 +219,10 @@ private:
     matrix matrixPR_;
     //! The next PR scaling step
     Step scalingStepPR_;
+    //! Whether positions are scaled on PR scaling steps
+    bool doPositionScaling_;
+    //! The position scaling matrix
+    matrix matrixPositionScaling_;
 
     // Access to ISimulator data
     //! Atom parameters for this domain.
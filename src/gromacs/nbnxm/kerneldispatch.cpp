@@ -36,6 +36,9 @@
 
 #include "gmxpre.h"
 
+#include <algorithm>
+#include <vector>
+
 #include "gromacs/gmxlib/nrnb.h"
 #include "gromacs/gmxlib/nonbonded/nb_free_energy.h"
 #include "gromacs/gmxlib/nonbonded/nb_kernel.h"
@@ -58,6 +61,7 @@
 #include "gromacs/timing/wallcycle.h"
 #include "gromacs/utility/gmxassert.h"
 #include "gromacs/utility/real.h"
+#include "gromacs/utility/taskgraph.h"
 
 #include "kernel_common.h"
 #include "nbnxm_gpu.h"
@@ -455,6 +459,41 @@ void nonbonded_verlet_t::dispatchNonbondedKernel(gmx::InteractionLocality   iLoc
     accountFlops(nrnb, pairlistSet, *this, ic, stepWork);
 }
 
+//! The number of chunks per thread the perturbed pair lists are split into
+static constexpr int c_numFepChunksPerThread = 4;
+//! The minimum number of perturbed pairs in a chunk, to limit the task overhead
+static constexpr int c_minNumFepPairsPerChunk = 64;
+
+/*! \brief Splits \p nlist into chunks of i-entries with about \p targetNumPairs j-entries each
+ *
+ * The chunks are appended to \p chunks. They share the i- and j-arrays
+ * of \p nlist, so \p nlist should not change while the chunks are in use.
+ */
+static void splitFepList(const t_nblist&        nlist,
+                         const int              targetNumPairs,
+                         std::vector<t_nblist>* chunks)
+{
+    int iStart = 0;
+    while (iStart < nlist.nri)
+    {
+        int iEnd = iStart + 1;
+        while (iEnd < nlist.nri && nlist.jindex[iEnd] - nlist.jindex[iStart] < targetNumPairs)
+        {
+            iEnd++;
+        }
+
+        t_nblist chunk = nlist;
+        chunk.nri      = iEnd - iStart;
+        chunk.iinr     = nlist.iinr + iStart;
+        chunk.gid      = nlist.gid + iStart;
+        chunk.shift    = nlist.shift + iStart;
+        chunk.jindex   = nlist.jindex + iStart;
+        chunks->push_back(chunk);
+
+        iStart = iEnd;
+    }
+}
+
 void nonbonded_verlet_t::dispatchFreeEnergyKernel(gmx::InteractionLocality   iLocality,
                                                   const t_forcerec*          fr,
                                                   rvec                       x[],
@@ -500,20 +539,66 @@ void nonbonded_verlet_t::dispatchFreeEnergyKernel(gmx::InteractionLocality   iLo
     kernel_data.energygrp_elec = enerd->grpp.ener[egCOULSR].data();
     kernel_data.energygrp_vdw  = enerd->grpp.ener[egLJSR].data();
 
+    /* If we do foreign lambda and we have soft-core interactions
+     * we have to recalculate the (non-linear) energies contributions.
+     * This is done for all lambda values in the same pass over the pair lists
+     * that computes the forces.
+     */
+    const bool computeForeignLambda =
+            (fepvals->n_lambda > 0 && stepWork.computeDhdl && fepvals->sc_alpha != 0);
+    const int numLambdas =
+            (computeForeignLambda ? 1 + enerd->foreignLambdaTerms.numLambdas() : 0);
+    std::vector<real> lambdaCoul(numLambdas);
+    std::vector<real> lambdaVdw(numLambdas);
+    for (int i = 0; i < numLambdas; i++)
+    {
+        lambdaCoul[i] = (i == 0 ? lambda[efptCOUL] : fepvals->all_lambda[efptCOUL][i - 1]);
+        lambdaVdw[i]  = (i == 0 ? lambda[efptVDW] : fepvals->all_lambda[efptVDW][i - 1]);
+    }
+    std::vector<real> foreignEnergies(numLambdas, 0.0_real);
+    std::vector<real> foreignDvdl(numLambdas, 0.0_real);
+    kernel_data.numForeignLambdas = numLambdas;
+    kernel_data.foreignLambdaCoul = lambdaCoul.data();
+    kernel_data.foreignLambdaVdw  = lambdaVdw.data();
+    kernel_data.foreignEnergies   = foreignEnergies.data();
+    kernel_data.foreignDvdl       = foreignDvdl.data();
+
     GMX_ASSERT(gmx_omp_nthreads_get(emntNonbonded) == nbl_fep.ssize(),
                "Number of lists should be same as number of NB threads");
 
     wallcycle_sub_start(wcycle_, ewcsNONBONDED_FEP);
-#pragma omp parallel for schedule(static) num_threads(nbl_fep.ssize())
-    for (gmx::index th = 0; th < nbl_fep.ssize(); th++)
+
+    /* The perturbed pairs are often distributed very unevenly over the
+     * thread lists. We split the lists into more chunks than threads and
+     * let threads that run out of work steal chunks from other threads.
+     * The kernel uses atomic output, so any thread can process any chunk.
+     */
+    const int numThreads = nbl_fep.ssize();
+    int       numPairs   = 0;
+    for (const auto& nbl : nbl_fep)
     {
-        try
-        {
-            gmx_nb_free_energy_kernel(nbl_fep[th].get(), x, forceWithShiftForces, fr, &mdatoms,
-                                      &kernel_data, nrnb);
-        }
-        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+        numPairs += nbl->jindex[nbl->nri];
+    }
+    const int targetNumPairsPerChunk =
+            std::max(numPairs / (numThreads * c_numFepChunksPerThread), c_minNumFepPairsPerChunk);
+    std::vector<t_nblist> fepChunks;
+    for (const auto& nbl : nbl_fep)
+    {
+        splitFepList(*nbl, targetNumPairsPerChunk, &fepChunks);
+    }
+
+    /* The per-thread soft-core pair buffers keep their memory over steps */
+    fepSoftCorePairs_.resize(numThreads);
+
+    gmx::TaskGraph fepTasks;
+    for (t_nblist& chunk : fepChunks)
+    {
+        fepTasks.addTask([&, nlist = &chunk](int thread) {
+            gmx_nb_free_energy_kernel(nlist, x, forceWithShiftForces, fr, &mdatoms, &kernel_data,
+                                      &fepSoftCorePairs_[thread], nrnb);
+        });
     }
+    fepTasks.run(numThreads);
 
     if (fepvals->sc_alpha != 0)
     {
@@ -526,42 +611,9 @@ void nonbonded_verlet_t::dispatchFreeEnergyKernel(gmx::InteractionLocality   iLo
         enerd->dvdl_lin[efptCOUL] += dvdl_nb[efptCOUL];
     }
 
-    /* If we do foreign lambda and we have soft-core interactions
-     * we have to recalculate the (non-linear) energies contributions.
-     */
-    if (fepvals->n_lambda > 0 && stepWork.computeDhdl && fepvals->sc_alpha != 0)
+    for (int i = 0; i < numLambdas; i++)
     {
-        real lam_i[efptNR];
-        kernel_data.flags = (donb_flags & ~(GMX_NONBONDED_DO_FORCE | GMX_NONBONDED_DO_SHIFTFORCE))
-                            | GMX_NONBONDED_DO_FOREIGNLAMBDA;
-        kernel_data.lambda         = lam_i;
-        kernel_data.dvdl           = dvdl_nb;
-        kernel_data.energygrp_elec = enerd->foreign_grpp.ener[egCOULSR].data();
-        kernel_data.energygrp_vdw  = enerd->foreign_grpp.ener[egLJSR].data();
-
-        for (gmx::index i = 0; i < 1 + enerd->foreignLambdaTerms.numLambdas(); i++)
-        {
-            std::fill(std::begin(dvdl_nb), std::end(dvdl_nb), 0);
-            for (int j = 0; j < efptNR; j++)
-            {
-                lam_i[j] = (i == 0 ? lambda[j] : fepvals->all_lambda[j][i - 1]);
-            }
-            reset_foreign_enerdata(enerd);
-#pragma omp parallel for schedule(static) num_threads(nbl_fep.ssize())
-            for (gmx::index th = 0; th < nbl_fep.ssize(); th++)
-            {
-                try
-                {
-                    gmx_nb_free_energy_kernel(nbl_fep[th].get(), x, forceWithShiftForces, fr,
-                                              &mdatoms, &kernel_data, nrnb);
-                }
-                GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
-            }
-
-            sum_epot(enerd->foreign_grpp, enerd->foreign_term);
-            enerd->foreignLambdaTerms.accumulate(i, enerd->foreign_term[F_EPOT],
-                                                 dvdl_nb[efptVDW] + dvdl_nb[efptCOUL]);
-        }
+        enerd->foreignLambdaTerms.accumulate(i, foreignEnergies[i], foreignDvdl[i]);
     }
     wallcycle_sub_stop(wcycle_, ewcsNONBONDED_FEP);
 }
@@ -112,6 +112,7 @@
 #define GMX_NBNXM_NBNXM_H
 
 #include <memory>
+#include <vector>
 
 #include "gromacs/gpu_utils/devicebuffer_datatype.h"
 #include "gromacs/math/vectypes.h"
@@ -132,6 +133,7 @@ struct nbnxn_atomdata_t;
 struct nonbonded_verlet_t;
 class PairSearch;
 class PairlistSets;
+struct SoftCorePairs;
 struct t_commrec;
 struct t_lambda;
 struct t_mdatoms;
@@ -400,6 +402,8 @@ private:
     Nbnxm::KernelSetup kernelSetup_;
     //! \brief Pointer to wallcycle structure.
     gmx_wallcycle* wcycle_;
+    //! Per-thread buffers for the soft-core pairs in the free-energy kernel, kept over steps
+    std::vector<SoftCorePairs> fepSoftCorePairs_;
 
 public:
     //! GPU Nbnxm data, only used with a physical GPU (TODO: use unique_ptr)
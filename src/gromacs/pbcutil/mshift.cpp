@@ -831,6 +831,190 @@ void mk_mshift(FILE* log, t_graph* g, PbcType pbcType, const matrix box, const r
     }
 }
 
+t_graph_traversal mk_graph_traversal(const t_graph& g)
+{
+    t_graph_traversal traversal;
+
+    traversal.partAtomStart.push_back(0);
+    traversal.partCheckStart.push_back(0);
+
+    const int          g0 = g.edgeAtomBegin;
+    std::vector<egCol> edgeColor(g.edges.size(), egcolWhite);
+
+    /* This follows the loops in mk_mshift and mk_grey, but only stores
+     * the order in which the atoms are visited.
+     */
+    int nW = g.numConnectedAtoms;
+    int fW = 0;
+    while (nW > 0)
+    {
+        fW = first_colour(fW, egcolWhite, &g, edgeColor);
+        GMX_RELEASE_ASSERT(fW >= 0, "There should be a white node left");
+
+        edgeColor[fW] = egcolGrey;
+        nW--;
+        int nG = 1;
+        traversal.atoms.push_back(g0 + fW);
+        traversal.parentAtoms.push_back(-1);
+
+        int fG = fW;
+        while (nG > 0)
+        {
+            fG = first_colour(fG, egcolGrey, &g, edgeColor);
+            GMX_RELEASE_ASSERT(fG >= 0, "There should be a grey node left");
+
+            edgeColor[fG] = egcolBlack;
+            nG--;
+
+            const int ai = g0 + fG;
+            for (const int aj : g.edges[ai - g0])
+            {
+                if (edgeColor[aj - g0] == egcolWhite)
+                {
+                    fG                 = std::min(fG, aj - g0);
+                    edgeColor[aj - g0] = egcolGrey;
+                    nG++;
+                    nW--;
+                    traversal.atoms.push_back(aj);
+                    traversal.parentAtoms.push_back(ai);
+                }
+                else
+                {
+                    traversal.checkAtoms.push_back(ai);
+                    traversal.checkAtoms.push_back(aj);
+                }
+            }
+        }
+
+        traversal.partAtomStart.push_back(traversal.atoms.size());
+        traversal.partCheckStart.push_back(traversal.checkAtoms.size());
+    }
+
+    return traversal;
+}
+
+/* Returns the index of the first part in traversal that starts at or after atomIndex */
+static int firstPartFrom(const t_graph_traversal& traversal, int atomIndex)
+{
+    const auto partEnd = traversal.partAtomStart.end() - 1;
+
+    return std::lower_bound(traversal.partAtomStart.begin(), partEnd, atomIndex)
+           - traversal.partAtomStart.begin();
+}
+
+bool shift_self_whole(t_graph*                 g,
+                      const t_graph_traversal& traversal,
+                      PbcType                  pbcType,
+                      const matrix             box,
+                      rvec                     x[],
+                      int                      numThreads)
+{
+    if (pbcType == PbcType::Screw)
+    {
+        return false;
+    }
+
+    g->useScrewPbc = false;
+
+    const int npbcdim = (pbcType == PbcType::XY ? 2 : 3);
+    rvec      hbox;
+    for (int m = 0; m < DIM; m++)
+    {
+        hbox[m] = box[m][m] * 0.5;
+    }
+    const bool bTriclinic = TRICLINIC(box);
+
+    ArrayRef<IVec> ishift   = g->ishift;
+    const int      numAtoms = traversal.atoms.size();
+
+    /* Set the shifts, each thread processes whole parts with in total
+     * about the same number of atoms as the other threads.
+     */
+    int numInconsistent = 0;
+#pragma omp parallel for num_threads(numThreads) schedule(static) reduction(+ : numInconsistent)
+    for (int thread = 0; thread < numThreads; thread++)
+    {
+        const int partBegin = firstPartFrom(traversal, (numAtoms * thread) / numThreads);
+        const int partEnd   = firstPartFrom(traversal, (numAtoms * (thread + 1)) / numThreads);
+
+        for (int part = partBegin; part < partEnd; part++)
+        {
+            for (int i = traversal.partAtomStart[part]; i < traversal.partAtomStart[part + 1]; i++)
+            {
+                const int aj = traversal.atoms[i];
+                const int ai = traversal.parentAtoms[i];
+                if (ai < 0)
+                {
+                    ishift[aj] = { 0, 0, 0 };
+                }
+                else if (bTriclinic)
+                {
+                    mk_1shift_tric(npbcdim, box, hbox, x[ai], x[aj], ishift[ai], ishift[aj]);
+                }
+                else
+                {
+                    mk_1shift(npbcdim, hbox, x[ai], x[aj], ishift[ai], ishift[aj]);
+                }
+            }
+            const int checkEnd = traversal.partCheckStart[part + 1];
+            for (int i = traversal.partCheckStart[part]; i < checkEnd; i += 2)
+            {
+                const int ai = traversal.checkAtoms[i];
+                const int aj = traversal.checkAtoms[i + 1];
+                ivec      is_aj;
+                if (bTriclinic)
+                {
+                    mk_1shift_tric(npbcdim, box, hbox, x[ai], x[aj], ishift[ai], is_aj);
+                }
+                else
+                {
+                    mk_1shift(npbcdim, hbox, x[ai], x[aj], ishift[ai], is_aj);
+                }
+                if ((is_aj[XX] != ishift[aj][XX]) || (is_aj[YY] != ishift[aj][YY])
+                    || (is_aj[ZZ] != ishift[aj][ZZ]))
+                {
+                    numInconsistent++;
+                }
+            }
+        }
+    }
+
+    if (numInconsistent > 0)
+    {
+        return false;
+    }
+
+    /* Apply the shifts, as in shift_self */
+    const int g0 = g->edgeAtomBegin;
+    const int g1 = g->edgeAtomEnd;
+    if (bTriclinic)
+    {
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (int j = g0; j < g1; j++)
+        {
+            const int tx = ishift[j][XX];
+            const int ty = ishift[j][YY];
+            const int tz = ishift[j][ZZ];
+
+            x[j][XX] = x[j][XX] + tx * box[XX][XX] + ty * box[YY][XX] + tz * box[ZZ][XX];
+            x[j][YY] = x[j][YY] + ty * box[YY][YY] + tz * box[ZZ][YY];
+            x[j][ZZ] = x[j][ZZ] + tz * box[ZZ][ZZ];
+        }
+    }
+    else
+    {
+#pragma omp parallel for num_threads(numThreads) schedule(static)
+        for (int j = g0; j < g1; j++)
+        {
+            x[j][XX] = x[j][XX] + ishift[j][XX] * box[XX][XX];
+            x[j][YY] = x[j][YY] + ishift[j][YY] * box[YY][YY];
+            x[j][ZZ] = x[j][ZZ] + ishift[j][ZZ] * box[ZZ][ZZ];
+        }
+    }
+
+    return true;
+}
+
 /************************************************************
  *
  *      A C T U A L   S H I F T   C O D E
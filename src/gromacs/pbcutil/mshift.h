@@ -101,6 +101,26 @@ struct t_graph
 
 #define SHIFT_IVEC(g, i) ((g)->ishift[i])
 
+/* The order in which mk_mshift visits the atoms of a graph
+ *
+ * This order only depends on the connectivity, so it can be determined once
+ * and reused for every set of coordinates. The graph consists of separate
+ * parts, usually molecules, that can then be processed independently.
+ */
+struct t_graph_traversal
+{
+    // The atoms in the order they are visited
+    std::vector<int> atoms;
+    // For each visited atom, the atom it gets its shift from, -1 for the first atom of a part
+    std::vector<int> parentAtoms;
+    // The start of each part in atoms, with one extra element for the end
+    std::vector<int> partAtomStart;
+    // Pairs of atoms connected by edges not used for setting shifts, their shifts are checked
+    std::vector<int> checkAtoms;
+    // The start of each part in checkAtoms, with one extra element for the end
+    std::vector<int> partCheckStart;
+};
+
 t_graph mk_graph(const InteractionDefinitions& idef, int numAtoms);
 /* Build a graph from an idef description. The graph can be used
  * to generate mol-shift indices.
@@ -142,6 +162,22 @@ void p_graph(FILE* log, const char* title, const t_graph* g);
 void mk_mshift(FILE* log, t_graph* g, PbcType pbcType, const matrix box, const rvec x[]);
 /* Calculate the mshift codes, based on the connection graph in g. */
 
+t_graph_traversal mk_graph_traversal(const t_graph& g);
+/* Returns the order in which mk_mshift visits the atoms of graph g */
+
+bool shift_self_whole(t_graph*                 g,
+                      const t_graph_traversal& traversal,
+                      PbcType                  pbcType,
+                      const matrix             box,
+                      rvec                     x[],
+                      int                      numThreads);
+/* Makes the parts of graph g whole in place, which gives the same result
+ * as mk_mshift followed by shift_self. Uses the precomputed traversal of g
+ * and processes the parts in parallel using numThreads OpenMP threads.
+ * Returns false, without changing x, when shifts are inconsistent or with
+ * screw PBC, then mk_mshift should be called, which handles these cases.
+ */
+
 void shift_x(const t_graph* g, const matrix box, const rvec x[], rvec x_s[]);
 /* Add the shift vector to x, and store in x_s (may be same array as x) */
 
@@ -43,6 +43,7 @@
 #include <cstdlib>
 
 #include <algorithm>
+#include <vector>
 
 #include "gromacs/math/vec.h"
 #include "gromacs/pbcutil/mshift.h"
@@ -52,28 +53,27 @@
 #include "gromacs/trajectory/trajectoryframe.h"
 #include "gromacs/utility/fatalerror.h"
 #include "gromacs/utility/futil.h"
-#include "gromacs/utility/smalloc.h"
+#include "gromacs/utility/gmxomp.h"
 
-typedef struct
+struct rmpbc_graph_t
 {
     int      natoms;
     t_graph* gr;
-} rmpbc_graph_t;
+    /* The order in which the atoms of gr are visited, computed once */
+    t_graph_traversal traversal;
+};
 
 struct gmx_rmpbc
 {
-    const InteractionDefinitions* interactionDefinitions;
-    const t_idef*                 idef;
-    int                           natoms_init;
-    PbcType                       pbcType;
-    int                           ePBC;
-    int                           ngraph;
-    rmpbc_graph_t*                graph;
+    const InteractionDefinitions* interactionDefinitions = nullptr;
+    const t_idef*                 idef                   = nullptr;
+    int                           natoms_init            = 0;
+    PbcType                       pbcType                = PbcType::Unset;
+    std::vector<rmpbc_graph_t>    graph;
 };
 
-static t_graph* gmx_rmpbc_get_graph(gmx_rmpbc_t gpbc, PbcType pbcType, int natoms)
+static rmpbc_graph_t* gmx_rmpbc_get_graph(gmx_rmpbc_t gpbc, PbcType pbcType, int natoms)
 {
-    int            i;
     rmpbc_graph_t* gr;
 
     if (pbcType == PbcType::No || nullptr == gpbc || nullptr == gpbc->idef || gpbc->idef->ntypes <= 0)
@@ -82,11 +82,11 @@ static t_graph* gmx_rmpbc_get_graph(gmx_rmpbc_t gpbc, PbcType pbcType, int natom
     }
 
     gr = nullptr;
-    for (i = 0; i < gpbc->ngraph; i++)
+    for (rmpbc_graph_t& graph : gpbc->graph)
     {
-        if (natoms == gpbc->graph[i].natoms)
+        if (natoms == graph.natoms)
         {
-            gr = &gpbc->graph[i];
+            gr = &graph;
         }
     }
     if (gr == nullptr)
@@ -102,9 +102,8 @@ static t_graph* gmx_rmpbc_get_graph(gmx_rmpbc_t gpbc, PbcType pbcType, int natom
                       "Structure or trajectory file has more atoms (%d) than the topology (%d)",
                       natoms, gpbc->natoms_init);
         }
-        gpbc->ngraph++;
-        srenew(gpbc->graph, gpbc->ngraph);
-        gr         = &gpbc->graph[gpbc->ngraph - 1];
+        gpbc->graph.emplace_back();
+        gr         = &gpbc->graph.back();
         gr->natoms = natoms;
         if (gpbc->interactionDefinitions)
         {
@@ -114,16 +113,25 @@ static t_graph* gmx_rmpbc_get_graph(gmx_rmpbc_t gpbc, PbcType pbcType, int natom
         {
             gr->gr = mk_graph(nullptr, gpbc->idef, natoms, FALSE, FALSE);
         }
+        gr->traversal = mk_graph_traversal(*gr->gr);
     }
 
-    return gr->gr;
+    return gr;
 }
 
-gmx_rmpbc_t gmx_rmpbc_init(const InteractionDefinitions& idef, PbcType pbcType, int natoms)
+/* Makes the molecules in x whole, using multiple threads when possible */
+static void gmx_rmpbc_shift_self(rmpbc_graph_t* gr, PbcType pbcType, const matrix box, rvec x[])
 {
-    gmx_rmpbc_t gpbc;
+    if (!shift_self_whole(gr->gr, gr->traversal, pbcType, box, x, gmx_omp_get_max_threads()))
+    {
+        mk_mshift(stdout, gr->gr, pbcType, box, x);
+        shift_self(gr->gr, box, x);
+    }
+}
 
-    snew(gpbc, 1);
+gmx_rmpbc_t gmx_rmpbc_init(const InteractionDefinitions& idef, PbcType pbcType, int natoms)
+{
+    gmx_rmpbc_t gpbc = new struct gmx_rmpbc;
 
     gpbc->natoms_init = natoms;
 
@@ -139,9 +147,7 @@ gmx_rmpbc_t gmx_rmpbc_init(const InteractionDefinitions& idef, PbcType pbcType,
 
 gmx_rmpbc_t gmx_rmpbc_init(const t_idef* idef, PbcType pbcType, int natoms)
 {
-    gmx_rmpbc_t gpbc;
-
-    snew(gpbc, 1);
+    gmx_rmpbc_t gpbc = new struct gmx_rmpbc;
 
     gpbc->natoms_init = natoms;
 
@@ -166,19 +172,13 @@ gmx_rmpbc_t gmx_rmpbc_init(const t_idef* idef, PbcType pbcType, int natoms)
 
 void gmx_rmpbc_done(gmx_rmpbc_t gpbc)
 {
-    int i;
-
     if (nullptr != gpbc)
     {
-        for (i = 0; i < gpbc->ngraph; i++)
-        {
-            delete gpbc->graph[i].gr;
-        }
-        if (gpbc->graph != nullptr)
+        for (rmpbc_graph_t& graph : gpbc->graph)
         {
-            sfree(gpbc->graph);
+            delete graph.gr;
         }
-        sfree(gpbc);
+        delete gpbc;
     }
 }
 
@@ -196,44 +196,41 @@ static PbcType gmx_rmpbc_ePBC(gmx_rmpbc_t gpbc, const matrix box)
 
 void gmx_rmpbc(gmx_rmpbc_t gpbc, int natoms, const matrix box, rvec x[])
 {
-    PbcType  pbcType;
-    t_graph* gr;
+    PbcType        pbcType;
+    rmpbc_graph_t* gr;
 
     pbcType = gmx_rmpbc_ePBC(gpbc, box);
     gr      = gmx_rmpbc_get_graph(gpbc, pbcType, natoms);
     if (gr != nullptr)
     {
-        mk_mshift(stdout, gr, pbcType, box, x);
-        shift_self(gr, box, x);
+        gmx_rmpbc_shift_self(gr, pbcType, box, x);
     }
 }
 
 void gmx_rmpbc_copy(gmx_rmpbc_t gpbc, int natoms, const matrix box, rvec x[], rvec x_s[])
 {
-    PbcType  pbcType;
-    t_graph* gr;
-    int      i;
+    PbcType        pbcType;
+    rmpbc_graph_t* gr;
+    int            i;
 
     pbcType = gmx_rmpbc_ePBC(gpbc, box);
     gr      = gmx_rmpbc_get_graph(gpbc, pbcType, natoms);
-    if (gr != nullptr)
+    for (i = 0; i < natoms; i++)
     {
-        mk_mshift(stdout, gr, pbcType, box, x);
-        shift_x(gr, box, x, x_s);
+        copy_rvec(x[i], x_s[i]);
     }
-    else
+    if (gr != nullptr
+        && !shift_self_whole(gr->gr, gr->traversal, pbcType, box, x_s, gmx_omp_get_max_threads()))
     {
-        for (i = 0; i < natoms; i++)
-        {
-            copy_rvec(x[i], x_s[i]);
-        }
+        mk_mshift(stdout, gr->gr, pbcType, box, x);
+        shift_x(gr->gr, box, x, x_s);
     }
 }
 
 void gmx_rmpbc_trxfr(gmx_rmpbc_t gpbc, t_trxframe* fr)
 {
-    PbcType  pbcType;
-    t_graph* gr;
+    PbcType        pbcType;
+    rmpbc_graph_t* gr;
 
     if (fr->bX && fr->bBox)
     {
@@ -241,8 +238,7 @@ void gmx_rmpbc_trxfr(gmx_rmpbc_t gpbc, t_trxframe* fr)
         gr      = gmx_rmpbc_get_graph(gpbc, pbcType, fr->natoms);
         if (gr != nullptr)
         {
-            mk_mshift(stdout, gr, pbcType, fr->box, fr->x);
-            shift_self(gr, fr->box, fr->x);
+            gmx_rmpbc_shift_self(gr, pbcType, fr->box, fr->x);
         }
     }
 }
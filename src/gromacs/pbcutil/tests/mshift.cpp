@@ -153,6 +153,58 @@ TEST(MShift, shiftsAndUnshiftsSelf)
     EXPECT_THAT(coordinates(), Pointwise(RVecEq(defaultFloatTolerance()), x));
 }
 
+//! Tests that making whole with a precomputed traversal matches mk_mshift with shift_self
+TEST(MShift, shiftsSelfWholeWithTraversal)
+{
+    // Molecules of 5 atoms with a ring of 4 atoms, so some edges are only checked
+    const int numMolecules   = 30;
+    const int numAtomsPerMol = 5;
+    const int ringBonds[5][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 0 }, { 3, 4 } };
+
+    gmx_moltype_t molType = {};
+    molType.atoms.nr      = numMolecules * numAtomsPerMol;
+    std::vector<int>& bonds = molType.ilist[F_BONDS].iatoms;
+    for (int m = 0; m < numMolecules; m++)
+    {
+        for (const auto& bond : ringBonds)
+        {
+            bonds.push_back(0);
+            bonds.push_back(m * numAtomsPerMol + bond[0]);
+            bonds.push_back(m * numAtomsPerMol + bond[1]);
+        }
+    }
+
+    const matrix box = { { 3, 0, 0 }, { 0.5, 3, 0 }, { -0.6, 0.4, 3 } };
+
+    // Whole molecules put in the box per atom, so most molecules are broken
+    std::vector<RVec> x;
+    for (int m = 0; m < numMolecules; m++)
+    {
+        const RVec center(0.1 * m, 0.17 * m, 0.23 * m);
+        for (int a = 0; a < numAtomsPerMol; a++)
+        {
+            x.emplace_back(center[XX] + 0.1 * a, center[YY] - 0.07 * a,
+                           center[ZZ] + 0.05 * (a % 2));
+        }
+    }
+    put_atoms_in_box(PbcType::Xyz, box, x);
+
+    std::vector<RVec> xReference = x;
+    t_graph           graph      = mk_graph_moltype(molType);
+    mk_mshift(nullptr, &graph, PbcType::Xyz, box, as_rvec_array(xReference.data()));
+    shift_self(&graph, box, as_rvec_array(xReference.data()));
+
+    const t_graph_traversal traversal = mk_graph_traversal(graph);
+    EXPECT_EQ(numMolecules, gmx::ssize(traversal.partAtomStart) - 1);
+    for (int numThreads : { 1, 4 })
+    {
+        std::vector<RVec> xWhole = x;
+        EXPECT_TRUE(shift_self_whole(&graph, traversal, PbcType::Xyz, box,
+                                     as_rvec_array(xWhole.data()), numThreads));
+        EXPECT_THAT(xReference, Pointwise(RVecEq(ulpTolerance(0)), xWhole));
+    }
+}
+
 } // namespace
 } // namespace test
 } // namespace gmx
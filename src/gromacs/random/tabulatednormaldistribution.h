@@ -309,6 +309,17 @@ public:
         return param.mean() + value * param.stddev();
     }
 
+    /*! \brief Return the standard normal value for the lowest tableBits bits of \p randomBits
+     *
+     * This returns the same value as operator() with mean 0 and standard deviation 1
+     * would return for these bits. It can be used with random bits that are
+     * generated for many streams at once, see threeFry2x64FirstValues().
+     */
+    static result_type valueFromBits(uint64_t randomBits)
+    {
+        return c_table_[randomBits & ((1ULL << tableBits) - 1)];
+    }
+
     /*!\brief Check if two tabulated normal distributions have identical states.
      *
      * \param  x     Instance to compare with.
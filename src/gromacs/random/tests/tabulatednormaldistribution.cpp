@@ -154,6 +154,23 @@ TEST(TabulatedNormalDistributionTest, AltParam)
     EXPECT_REAL_EQ_TOL(distA(rngA), distB(rngB, paramA), gmx::test::ulpTolerance(0));
 }
 
+TEST(TabulatedNormalDistributionTest, ValueFromBits)
+{
+    using Distribution = gmx::TabulatedNormalDistribution<real, 14>;
+
+    gmx::ThreeFry2x64<0> rng(123456, gmx::RandomDomain::Other);
+    Distribution         dist;
+
+    uint64_t bits = rng();
+    rng.restart();
+    dist.reset();
+    for (int i = 0; i < 4; i++)
+    {
+        EXPECT_REAL_EQ_TOL(dist(rng), Distribution::valueFromBits(bits), gmx::test::ulpTolerance(0));
+        bits >>= 14;
+    }
+}
+
 TEST(TabulatedNormalDistributionTableTest, HasValidProperties)
 {
     auto table = TabulatedNormalDistribution<real>::makeTable();
@@ -216,6 +216,35 @@ TEST_F(ThreeFry2x64Test, Discard)
     EXPECT_EQ(rngA, rngB);
 }
 
+TEST_F(ThreeFry2x64Test, FirstValuesMatchScalarEngine)
+{
+    // Use a count that is not a multiple of the internal batch size
+    const int             numStreams = 21;
+    const uint64_t        seed       = 123456;
+    const uint64_t        step       = 0xFEDCBA9876543210;
+    std::vector<uint64_t> counters(numStreams);
+    for (int i = 0; i < numStreams; i++)
+    {
+        counters[i] = 7 * i + (i % 3 == 0 ? 0x8000000000000000 : 0);
+    }
+    std::vector<uint64_t> resultDefault(numStreams);
+    std::vector<uint64_t> resultFast(numStreams);
+
+    gmx::threeFry2x64FirstValues<20>(seed, gmx::RandomDomain::UpdateCoordinates, step, counters,
+                                     resultDefault);
+    gmx::threeFry2x64FirstValues<13>(seed, gmx::RandomDomain::UpdateCoordinates, step, counters,
+                                     resultFast);
+
+    gmx::ThreeFry2x64<0>     rngDefault(seed, gmx::RandomDomain::UpdateCoordinates);
+    gmx::ThreeFry2x64Fast<0> rngFast(seed, gmx::RandomDomain::UpdateCoordinates);
+    for (int i = 0; i < numStreams; i++)
+    {
+        rngDefault.restart(step, counters[i]);
+        rngFast.restart(step, counters[i]);
+        EXPECT_EQ(rngDefault(), resultDefault[i]) << "for stream " << i;
+        EXPECT_EQ(rngFast(), resultFast[i]) << "for stream " << i;
+    }
+}
 
 TEST_F(ThreeFry2x64Test, InvalidCounter)
 {
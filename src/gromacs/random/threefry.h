@@ -44,13 +44,16 @@
 #ifndef GMX_RANDOM_THREEFRY_H
 #define GMX_RANDOM_THREEFRY_H
 
+#include <algorithm>
 #include <array>
 #include <limits>
 
 #include "gromacs/math/functions.h"
 #include "gromacs/random/seed.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/classhelpers.h"
 #include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/gmxassert.h"
 
 /*
  * The GROMACS implementation of the ThreeFry random engine has been
@@ -888,6 +891,79 @@ public:
  */
 typedef ThreeFry2x64Fast<> DefaultRandomEngine;
 
+/*! \brief Generates the first random value of many ThreeFry2x64 streams at once
+ *
+ *  \tparam rounds   The number of encryption rounds, 20 for ThreeFry2x64
+ *                   and 13 for ThreeFry2x64Fast.
+ *  \param  key0     First word of the key, i.e. the random seed.
+ *  \param  domain   The random domain, i.e. the second word of the key.
+ *  \param  counter0 The first word of the counter for all streams.
+ *  \param  counter1 The second words of the counters of the streams.
+ *  \param  result   The first random value of each stream, same size as \p counter1.
+ *
+ *  \p result[i] is bitwise identical to the first value returned by a
+ *  ThreeFry2x64General<rounds, 0> engine seeded with \p key0 and \p domain
+ *  and restarted with \p counter0 and \p counter1[i]. This is the common
+ *  pattern of restarting a stream for each atom with the step and the atom
+ *  index as counter. Here the encryption rounds are applied to a batch of
+ *  streams in loops over the batch, which the compiler can vectorize.
+ *  Note that this only supports engines without internal counter bits.
+ */
+template<unsigned int rounds>
+void threeFry2x64FirstValues(uint64_t                  key0,
+                             RandomDomain              domain,
+                             uint64_t                  counter0,
+                             ArrayRef<const uint64_t>  counter1,
+                             ArrayRef<uint64_t>        result)
+{
+    static_assert(rounds >= 13,
+                  "You should not use less than 13 encryption rounds for ThreeFry2x64.");
+    GMX_ASSERT(counter1.size() == result.size(), "Need one result per counter");
+
+    constexpr unsigned int rotations[] = { 16, 42, 12, 31, 16, 32, 24, 21 };
+    constexpr int          c_batchSize = 8;
+
+    const uint64_t key1  = static_cast<uint64_t>(domain);
+    const uint64_t ks[3] = { key0, key1, 0x1bd11bdaa9fc1a22 ^ key0 ^ key1 };
+
+    const int numStreams = counter1.ssize();
+    for (int batchStart = 0; batchStart < numStreams; batchStart += c_batchSize)
+    {
+        const int numInBatch = std::min(c_batchSize, numStreams - batchStart);
+
+        uint64_t x0[c_batchSize];
+        uint64_t x1[c_batchSize];
+        for (int i = 0; i < c_batchSize; i++)
+        {
+            x0[i] = counter0 + key0;
+            x1[i] = (i < numInBatch ? counter1[batchStart + i] : 0) + key1;
+        }
+        for (unsigned int r = 0; r < rounds; r++)
+        {
+            const unsigned int bits = rotations[r % 8];
+            for (int i = 0; i < c_batchSize; i++)
+            {
+                x0[i] += x1[i];
+                x1[i] = (x1[i] << bits) | (x1[i] >> (std::numeric_limits<uint64_t>::digits - bits));
+                x1[i] ^= x0[i];
+            }
+            if (((r + 1) & 3) == 0)
+            {
+                const unsigned int r4 = (r + 1) >> 2;
+                for (int i = 0; i < c_batchSize; i++)
+                {
+                    x0[i] += ks[r4 % 3];
+                    x1[i] += ks[(r4 + 1) % 3] + r4;
+                }
+            }
+        }
+        for (int i = 0; i < numInBatch; i++)
+        {
+            result[batchStart + i] = x0[i];
+        }
+    }
+}
+
 } // namespace gmx
 
 #endif // GMX_RANDOM_THREEFRY_H
@@ -149,6 +149,12 @@ void RestraintForceProvider::calculateForces(const ForceProviderInput& forceProv
     }
 }
 
+ForceProviderTimeScale RestraintForceProvider::timeScale() const
+{
+    return restraint_->isSlowlyVarying() ? ForceProviderTimeScale::Slow
+                                         : ForceProviderTimeScale::Fast;
+}
+
 RestraintMDModuleImpl::~RestraintMDModuleImpl() = default;
 
 RestraintMDModuleImpl::RestraintMDModuleImpl(std::shared_ptr<IRestraintPotential> restraint,
@@ -162,7 +168,7 @@ void RestraintMDModuleImpl::initForceProviders(ForceProviders* forceProviders)
 {
     GMX_ASSERT(forceProvider_, "Class invariant implies non-null ForceProvider member.");
     GMX_ASSERT(forceProviders, "Provided ForceProviders* assumed to be non-null.");
-    forceProviders->addForceProvider(forceProvider_.get());
+    forceProviders->addForceProvider(forceProvider_.get(), forceProvider_->timeScale());
 }
 
 
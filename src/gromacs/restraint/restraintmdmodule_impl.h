@@ -254,6 +254,9 @@ public:
     void calculateForces(const ForceProviderInput& forceProviderInput,
                          ForceProviderOutput*      forceProviderOutput) override;
 
+    //! The time scale on which the restraint forces vary
+    ForceProviderTimeScale timeScale() const;
+
 private:
     std::shared_ptr<gmx::IRestraintPotential> restraint_;
     std::vector<Site>                         sites_;
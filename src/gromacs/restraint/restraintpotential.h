@@ -199,6 +199,17 @@ public:
         (void)t;
     }
 
+    /*!
+     * \brief Whether the restraint forces vary slowly compared to the integration time step.
+     *
+     * With multiple time stepping, slowly varying restraints are only evaluated (and updated)
+     * every mts-level2-factor steps, with the impulse of their forces scaled by that factor.
+     * By default, restraints are evaluated every step.
+     *
+     * \return true if the restraint can be evaluated at the slow multiple time-stepping level
+     */
+    virtual bool isSlowlyVarying() const { return false; }
+
 
     /*!
      * \brief Find out what sites this restraint is configured to act on.
@@ -273,4 +273,76 @@ void PageAlignedAllocationPolicy::free(void* p)
     freeImpl(p);
 }
 
+// === NumaAwareAllocationPolicy
+
+namespace
+{
+
+/*! \brief The number of threads over which the calling thread distributes pages
+ *
+ * This is thread local, because with thread-MPI every rank is a thread
+ * that allocates its own buffers for its own team of OpenMP threads.
+ */
+thread_local int t_numThreadsForFirstTouch = 1;
+
+} // namespace
+
+std::size_t NumaAwareAllocationPolicy::alignment()
+{
+    return AlignedAllocationPolicy::alignment();
+}
+
+void NumaAwareAllocationPolicy::setNumThreadsForFirstTouch(int numThreads)
+{
+    GMX_RELEASE_ASSERT(numThreads >= 1, "Need at least one thread");
+    t_numThreadsForFirstTouch = numThreads;
+}
+
+void* NumaAwareAllocationPolicy::malloc(std::size_t bytes)
+{
+    const std::size_t pageSize   = PageAlignedAllocationPolicy::alignment();
+    const int         numThreads = t_numThreadsForFirstTouch;
+    if (numThreads == 1 || bytes < numThreads * pageSize)
+    {
+        return AlignedAllocationPolicy::malloc(bytes);
+    }
+
+    // Pad memory at the end, as AlignedAllocationPolicy does
+    bytes += alignment();
+
+    void* p = mallocImpl(bytes, pageSize);
+    if (p == nullptr)
+    {
+        return p;
+    }
+
+    /* Touch one byte per page, with thread th touching a contiguous
+     * fraction th/numThreads to (th+1)/numThreads of the pages. This is
+     * the static split that getThreadAtomRange() uses for the update,
+     * up to page granularity. We do not request transparent huge pages,
+     * because those would be placed in 2 MiB units at the first touch.
+     * The contents of the memory are undefined after allocation, so we
+     * can write anything.
+     */
+    char*             pChar    = static_cast<char*>(p);
+    const std::size_t numPages = (bytes + pageSize - 1) / pageSize;
+#pragma omp parallel for schedule(static) num_threads(numThreads)
+    for (int th = 0; th < numThreads; th++)
+    {
+        const std::size_t pageBegin = numPages * th / numThreads;
+        const std::size_t pageEnd   = numPages * (th + 1) / numThreads;
+        for (std::size_t page = pageBegin; page < pageEnd; page++)
+        {
+            pChar[page * pageSize] = 0;
+        }
+    }
+
+    return p;
+}
+
+void NumaAwareAllocationPolicy::free(void* p)
+{
+    freeImpl(p);
+}
+
 } // namespace gmx
@@ -162,6 +162,69 @@ public:
 template<class T>
 using PageAlignedAllocator = Allocator<T, PageAlignedAllocationPolicy>;
 
+/*! \libinternal \brief Policy class for configuring gmx::Allocator,
+ * to manage allocations of large arrays that are accessed by all
+ * OpenMP threads of a rank.
+ *
+ * After setNumThreadsForFirstTouch() was called with more than one
+ * thread, allocations that span at least one page per thread are page
+ * aligned and their pages are touched in parallel by that many OpenMP
+ * threads before returning, each thread touching a contiguous part.
+ * This matches the static atom partition used by the update, so with
+ * the first-touch policy of the operating system each page is placed
+ * on the NUMA node of the thread that updates it, instead of on the
+ * node of the thread that allocated the array. This only helps when
+ * the threads are pinned, so mdrun only enables it then. Other
+ * allocations are handled as by AlignedAllocationPolicy.
+ */
+class NumaAwareAllocationPolicy
+{
+public:
+    /*! \brief Return the minimum alignment size, as for AlignedAllocationPolicy */
+    static std::size_t alignment();
+    /*! \brief Sets the number of threads that touch the pages of large allocations
+     *
+     * The setting applies to allocations made by the calling thread, so
+     * each thread-MPI rank sets its own. The default of 1 disables the
+     * distribution of pages.
+     */
+    static void setNumThreadsForFirstTouch(int numThreads);
+    /*! \brief Allocate memory aligned to at least alignment() bytes.
+     *
+     *  \param bytes Amount of memory (bytes) to allocate. It is valid to ask for
+     *               0 bytes, which will return a non-null pointer that is properly
+     *               aligned and padded (but that you should not use).
+     *
+     * \return Valid pointer if the allocation worked, otherwise nullptr.
+     *
+     *  \note Memory allocated with this routine must be released with
+     *        gmx::NumaAwareAllocationPolicy::free(), and absolutely not the system free().
+     */
+    static void* malloc(std::size_t bytes);
+    /*! \brief Free aligned memory
+     *
+     *  \param p  Memory pointer previously returned from malloc()
+     *
+     *  \note This routine should only be called with pointers obtained from
+     *        gmx::NumaAwareAllocationPolicy::malloc(), and absolutely not any
+     *        pointers obtained the system malloc().
+     */
+    static void free(void* p);
+};
+
+/*! \brief NUMA-aware memory allocator.
+ *
+ *  \tparam T          Type of objects to allocate
+ *
+ * This convenience partial specialization can be used for the
+ * optional allocator template parameter in standard library
+ * containers for large arrays that are processed by all OpenMP
+ * threads, such as coordinate and force buffers. The memory will
+ * be allocated according to the behavior of NumaAwareAllocationPolicy.
+ */
+template<class T>
+using NumaAwareAllocator = Allocator<T, NumaAwareAllocationPolicy>;
+
 } // namespace gmx
 
 #endif // GMX_UTILITY_ALIGNEDALLOCATOR_H
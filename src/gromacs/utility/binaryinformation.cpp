@@ -281,6 +281,8 @@ void gmx_print_version_info(gmx::TextWriter* writer)
 
 #if GMX_DOUBLE
     writer->writeLine("Precision:          double");
+#elif GMX_MIXED_PRECISION_ACCUMULATION
+    writer->writeLine("Precision:          mixed (double-precision accumulation)");
 #else
     writer->writeLine("Precision:          single");
 #endif
@@ -45,6 +45,8 @@
 
 #include "config.h"
 
+#include <cstring>
+
 #include <algorithm>
 #include <vector>
 
@@ -144,6 +146,30 @@ public:
             CharBuffer<T>(value).appendTo(&buffer_);
         }
     }
+    //! Appends \p numValues values with a single resize of the buffer
+    template<typename T>
+    void doValueArray(const T* values, std::size_t numValues)
+    {
+        if (numValues == 0)
+        {
+            return;
+        }
+        const std::size_t pos = buffer_.size();
+        buffer_.resize(pos + numValues * sizeof(T));
+        char* destination = buffer_.data() + pos;
+        if (endianSwapBehavior_ == EndianSwapBehavior::Swap)
+        {
+            for (std::size_t i = 0; i < numValues; i++)
+            {
+                const T value = swapEndian(values[i]);
+                std::memcpy(destination + i * sizeof(T), &value, sizeof(T));
+            }
+        }
+        else
+        {
+            std::memcpy(destination, values, numValues * sizeof(T));
+        }
+    }
     void doString(const std::string& value)
     {
         doValue<uint64_t>(value.size());
@@ -246,6 +272,26 @@ void InMemorySerializer::doOpaque(char* data, std::size_t size)
     impl_->doOpaque(data, size);
 }
 
+void InMemorySerializer::doIntArray(int* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemorySerializer::doInt64Array(int64_t* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemorySerializer::doFloatArray(float* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemorySerializer::doDoubleArray(double* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
 /********************************************************************
  * InMemoryDeserializer
  */
@@ -274,6 +320,25 @@ public:
         }
         pos_ += CharBuffer<T>::ValueSize;
     }
+    //! Reads \p numValues consecutively stored values with a single copy
+    template<typename T>
+    void doValueArray(T* values, std::size_t numValues)
+    {
+        if (numValues == 0)
+        {
+            return;
+        }
+        const std::size_t numBytes = numValues * sizeof(T);
+        std::copy(&buffer_[pos_], &buffer_[pos_] + numBytes, reinterpret_cast<char*>(values));
+        if (endianSwapBehavior_ == EndianSwapBehavior::Swap)
+        {
+            for (std::size_t i = 0; i < numValues; i++)
+            {
+                values[i] = swapEndian(values[i]);
+            }
+        }
+        pos_ += numBytes;
+    }
     void doString(std::string* value)
     {
         uint64_t size;
@@ -376,6 +441,52 @@ void InMemoryDeserializer::doRvec(rvec* value)
     }
 }
 
+void InMemoryDeserializer::doIntArray(int* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemoryDeserializer::doInt64Array(int64_t* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemoryDeserializer::doFloatArray(float* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemoryDeserializer::doDoubleArray(double* values, int elements)
+{
+    impl_->doValueArray(values, elements);
+}
+
+void InMemoryDeserializer::doRvecArray(rvec* values, int elements)
+{
+    if (elements == 0)
+    {
+        return;
+    }
+
+    const std::size_t numValues = static_cast<std::size_t>(elements) * DIM;
+    if (sourceIsDouble() == (sizeof(real) == sizeof(double)))
+    {
+        impl_->doValueArray(values[0], numValues);
+    }
+    else if (sourceIsDouble())
+    {
+        std::vector<double> temp(numValues);
+        impl_->doValueArray(temp.data(), numValues);
+        std::copy(temp.begin(), temp.end(), values[0]);
+    }
+    else
+    {
+        std::vector<float> temp(numValues);
+        impl_->doValueArray(temp.data(), numValues);
+        std::copy(temp.begin(), temp.end(), values[0]);
+    }
+}
+
 void InMemoryDeserializer::doIvec(ivec* value)
 {
     for (int d = 0; d < DIM; d++)
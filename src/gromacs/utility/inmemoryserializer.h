@@ -92,6 +92,13 @@ public:
     void doRvec(rvec* value) override;
     void doString(std::string* value) override;
     void doOpaque(char* data, std::size_t size) override;
+    //! Writes the whole array at once, with bulk byte swapping when needed
+    ///@{
+    void doIntArray(int* values, int elements) override;
+    void doInt64Array(int64_t* values, int elements) override;
+    void doFloatArray(float* values, int elements) override;
+    void doDoubleArray(double* values, int elements) override;
+    ///@}
 
 private:
     class Impl;
@@ -126,6 +133,14 @@ public:
     void doRvec(rvec* value) override;
     void doString(std::string* value) override;
     void doOpaque(char* data, std::size_t size) override;
+    //! Reads the whole array at once, with bulk byte swapping when needed
+    ///@{
+    void doIntArray(int* values, int elements) override;
+    void doInt64Array(int64_t* values, int elements) override;
+    void doFloatArray(float* values, int elements) override;
+    void doDoubleArray(double* values, int elements) override;
+    void doRvecArray(rvec* values, int elements) override;
+    ///@}
 
 private:
     class Impl;
@@ -58,6 +58,38 @@ std::vector<std::string> splitPathElements(const std::string& path)
     return splitDelimitedString(path.substr(1), '/');
 }
 
+//! Helper function to format the elements of a typed array with values of type \p T.
+template<typename T>
+std::string typedArrayToString(const KeyValueTreeValue& value)
+{
+    std::string result;
+    for (const T& elem : value.asTypedArray<T>())
+    {
+        result.append(" ");
+        result.append(toString(elem));
+    }
+    return result;
+}
+
+//! Helper function to format the elements of a typed array.
+std::string typedArrayToString(const KeyValueTreeValue& value)
+{
+    if (value.isType<std::vector<int>>())
+    {
+        return typedArrayToString<int>(value);
+    }
+    else if (value.isType<std::vector<int64_t>>())
+    {
+        return typedArrayToString<int64_t>(value);
+    }
+    else if (value.isType<std::vector<float>>())
+    {
+        return typedArrayToString<float>(value);
+    }
+    GMX_RELEASE_ASSERT(value.isType<std::vector<double>>(), "Unknown typed array type");
+    return typedArrayToString<double>(value);
+}
+
 } // namespace
 
 /********************************************************************
@@ -130,6 +162,12 @@ void dumpKeyValueTree(TextWriter* writer, const KeyValueTreeObject& tree)
                 }
                 writer->writeString(" ]");
             }
+            else if (value.isTypedArray())
+            {
+                writer->writeString("[");
+                writer->writeString(typedArrayToString(value));
+                writer->writeString(" ]");
+            }
             else
             {
                 writer->writeString(simpleValueToString(value));
@@ -196,6 +234,10 @@ private:
             {
                 GMX_RELEASE_ASSERT(false, "Array comparison not implemented");
             }
+            else if (value1.isTypedArray())
+            {
+                compareTypedArrays(value1, value2);
+            }
             else if (!areSimpleValuesOfSameTypeEqual(value1, value2))
             {
                 writer_->writeString(currentPath_.toString());
@@ -221,6 +263,58 @@ private:
         }
     }
 
+    void compareTypedArrays(const KeyValueTreeValue& value1, const KeyValueTreeValue& value2)
+    {
+        if (value1.isType<std::vector<int>>())
+        {
+            compareTypedArrays(value1.asTypedArray<int>(), value2.asTypedArray<int>());
+        }
+        else if (value1.isType<std::vector<int64_t>>())
+        {
+            compareTypedArrays(value1.asTypedArray<int64_t>(), value2.asTypedArray<int64_t>());
+        }
+        else if (value1.isType<std::vector<float>>())
+        {
+            compareTypedArrays(value1.asTypedArray<float>(), value2.asTypedArray<float>());
+        }
+        else
+        {
+            compareTypedArrays(value1.asTypedArray<double>(), value2.asTypedArray<double>());
+        }
+    }
+
+    template<typename T>
+    void compareTypedArrays(ArrayRef<const T> array1, ArrayRef<const T> array2)
+    {
+        if (array1.size() != array2.size())
+        {
+            writer_->writeString(currentPath_.toString());
+            writer_->writeLine(formatString(" (%zu elements - %zu elements)", array1.size(),
+                                            array2.size()));
+            return;
+        }
+        for (size_t i = 0; i < array1.size(); i++)
+        {
+            if (!areValuesEqual(array1[i], array2[i]))
+            {
+                writer_->writeString(currentPath_.toString());
+                writer_->writeLine(formatString("[%zu] (%s - %s)", i, toString(array1[i]).c_str(),
+                                                toString(array2[i]).c_str()));
+            }
+        }
+    }
+
+    bool areValuesEqual(int value1, int value2) const { return value1 == value2; }
+    bool areValuesEqual(int64_t value1, int64_t value2) const { return value1 == value2; }
+    bool areValuesEqual(float value1, float value2) const
+    {
+        return equal_float(value1, value2, ftol_, abstol_);
+    }
+    bool areValuesEqual(double value1, double value2) const
+    {
+        return equal_double(value1, value2, ftol_, abstol_);
+    }
+
     bool areSimpleValuesOfSameTypeEqual(const KeyValueTreeValue& value1, const KeyValueTreeValue& value2)
     {
         GMX_ASSERT(value1.type() == value2.type(), "Caller should ensure that types are equal");
@@ -277,7 +371,7 @@ private:
 
     static std::string formatValueForMissingMessage(const KeyValueTreeValue& value)
     {
-        if (value.isObject() || value.isArray())
+        if (value.isObject() || value.isArray() || value.isTypedArray())
         {
             return "present";
         }
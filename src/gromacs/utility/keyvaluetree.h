@@ -43,6 +43,10 @@
  *  - _Array_ (gmx::KeyValueTreeArray) is a collection of any number of values
  *    (including zero).  The values can be of any type and different types
  *    can be mixed in the same array.
+ *  - _Typed array_ is a single value that stores a contiguous array of
+ *    numbers of one type (int, int64_t, float or double).  Unlike an
+ *    _Array_, it does not create a separate value per element, and is
+ *    meant for large numeric data such as module checkpoint state.
  *  - _Object_ (gmx::KeyValueTreeObject) is a collection of properties.
  *    Each property must have a unique key.  Order of properties is preserved,
  *    i.e., they can be iterated in the order they were added.
@@ -72,6 +76,7 @@
 #include <vector>
 
 #include "gromacs/utility/any.h"
+#include "gromacs/utility/arrayref.h"
 #include "gromacs/utility/real.h"
 
 namespace gmx
@@ -171,6 +176,8 @@ public:
     bool isArray() const;
     //! Returns whether the value is an object (KeyValueTreeObject).
     bool isObject() const;
+    //! Returns whether the value is a typed array of any supported type.
+    bool isTypedArray() const;
     //! Returns whether the value is of a given type.
     template<typename T>
     bool isType() const
@@ -189,6 +196,12 @@ public:
     {
         return value_.cast<T>();
     }
+    //! Returns the elements of a typed array with values of type \p T.
+    template<typename T>
+    ArrayRef<const T> asTypedArray() const
+    {
+        return value_.cast<std::vector<T>>();
+    }
 
     //! Returns the raw Any value (always possible).
     const Any& asAny() const { return value_; }
@@ -307,6 +320,11 @@ inline bool KeyValueTreeValue::isObject() const
 {
     return value_.isType<KeyValueTreeObject>();
 }
+inline bool KeyValueTreeValue::isTypedArray() const
+{
+    return value_.isType<std::vector<int>>() || value_.isType<std::vector<int64_t>>()
+           || value_.isType<std::vector<float>>() || value_.isType<std::vector<double>>();
+}
 inline const KeyValueTreeArray& KeyValueTreeValue::asArray() const
 {
     return value_.cast<KeyValueTreeArray>();
@@ -341,6 +341,19 @@ public:
             builder.addValue(value);
         }
     }
+    /*! \brief
+     * Adds a typed array-valued property with given key and values.
+     *
+     * \tparam T  Type of the values, one of int, int64_t, float or double.
+     *
+     * The values are stored contiguously in a single value, instead of as
+     * one value per element as with addUniformArray().
+     */
+    template<typename T>
+    void addTypedArray(const std::string& key, ArrayRef<const T> values)
+    {
+        addRawValue(key, Any::create<std::vector<T>>(std::vector<T>(values.begin(), values.end())));
+    }
     /*! \brief
      * Adds an array-valued property with objects in the array with given
      * key.
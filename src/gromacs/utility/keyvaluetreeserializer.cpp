@@ -36,6 +36,8 @@
 
 #include "keyvaluetreeserializer.h"
 
+#include <vector>
+
 #include "gromacs/utility/iserializer.h"
 #include "gromacs/utility/keyvaluetree.h"
 #include "gromacs/utility/keyvaluetreebuilder.h"
@@ -212,6 +214,45 @@ struct SerializationTraits<double>
     }
 };
 
+//! Helper functions for serializing the contents of typed arrays in bulk.
+//! \{
+void serializeArrayContents(int* values, int count, ISerializer* serializer)
+{
+    serializer->doIntArray(values, count);
+}
+void serializeArrayContents(int64_t* values, int count, ISerializer* serializer)
+{
+    serializer->doInt64Array(values, count);
+}
+void serializeArrayContents(float* values, int count, ISerializer* serializer)
+{
+    serializer->doFloatArray(values, count);
+}
+void serializeArrayContents(double* values, int count, ISerializer* serializer)
+{
+    serializer->doDoubleArray(values, count);
+}
+//! \}
+
+template<typename T>
+struct SerializationTraits<std::vector<T>>
+{
+    static void serialize(const std::vector<T>& values, ISerializer* serializer)
+    {
+        int count = values.size();
+        serializer->doInt(&count);
+        serializeArrayContents(const_cast<T*>(values.data()), count, serializer);
+    }
+    static void deserialize(KeyValueTreeValueBuilder* builder, ISerializer* serializer)
+    {
+        int count;
+        serializer->doInt(&count);
+        std::vector<T> values(count);
+        serializeArrayContents(values.data(), count, serializer);
+        builder->setAnyValue(Any::create<std::vector<T>>(std::move(values)));
+    }
+};
+
 //! Helper function for serializing values of a certain type.
 template<typename T>
 void serializeValueType(const KeyValueTreeValue& value, ISerializer* serializer)
@@ -244,6 +285,10 @@ void ValueSerializer::initSerializers()
         SERIALIZER('l', int64_t),
         SERIALIZER('f', float),
         SERIALIZER('d', double),
+        SERIALIZER('I', std::vector<int>),
+        SERIALIZER('L', std::vector<int64_t>),
+        SERIALIZER('F', std::vector<float>),
+        SERIALIZER('D', std::vector<double>),
     };
     for (const auto& item : s_serializers)
     {
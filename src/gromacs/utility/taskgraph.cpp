@@ -0,0 +1,227 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Implements gmx::TaskGraph.
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "taskgraph.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "gromacs/utility/exceptions.h"
+#include "gromacs/utility/gmxassert.h"
+#include "gromacs/utility/gmxomp.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+//! The deque of ready tasks of a thread, aligned to avoid false sharing between threads
+struct alignas(128) ThreadTaskDeque
+{
+    //! Protects \p tasks
+    std::mutex mutex;
+    //! The ready tasks, the owning thread takes from the front, other threads steal from the back
+    std::deque<TaskGraph::TaskId> tasks;
+};
+
+//! Takes a task from the front of \p deque, returns false when the deque is empty
+bool takeFront(ThreadTaskDeque* deque, TaskGraph::TaskId* task)
+{
+    std::lock_guard<std::mutex> lock(deque->mutex);
+    if (deque->tasks.empty())
+    {
+        return false;
+    }
+    *task = deque->tasks.front();
+    deque->tasks.pop_front();
+    return true;
+}
+
+//! Takes a task from the back of \p deque, returns false when the deque is empty
+bool takeBack(ThreadTaskDeque* deque, TaskGraph::TaskId* task)
+{
+    std::lock_guard<std::mutex> lock(deque->mutex);
+    if (deque->tasks.empty())
+    {
+        return false;
+    }
+    *task = deque->tasks.back();
+    deque->tasks.pop_back();
+    return true;
+}
+
+} // namespace
+
+TaskGraph::TaskId TaskGraph::addTask(TaskFunction task)
+{
+    tasks_.push_back(std::move(task));
+    successors_.emplace_back();
+    numPredecessors_.push_back(0);
+
+    return tasks_.size() - 1;
+}
+
+void TaskGraph::addDependency(const TaskId before, const TaskId after)
+{
+    if (before < 0 || before >= numTasks() || after < 0 || after >= numTasks())
+    {
+        GMX_THROW(InvalidInputError("Task dependency with an invalid task id"));
+    }
+    if (before == after)
+    {
+        GMX_THROW(InvalidInputError("A task can not depend on itself"));
+    }
+
+    successors_[before].push_back(after);
+    numPredecessors_[after]++;
+}
+
+void TaskGraph::clear()
+{
+    tasks_.clear();
+    successors_.clear();
+    numPredecessors_.clear();
+}
+
+void TaskGraph::run(const int numThreads) const
+{
+    GMX_RELEASE_ASSERT(numThreads >= 1, "Need at least one thread");
+
+    if (tasks_.empty())
+    {
+        return;
+    }
+
+    /* Collect the tasks without dependencies and check that all tasks
+     * can be reached, i.e. that there are no cycles.
+     */
+    std::vector<TaskId> initialTasks;
+    {
+        std::vector<int>    numPredecessors = numPredecessors_;
+        std::vector<TaskId> orderedTasks;
+        for (TaskId task = 0; task < numTasks(); task++)
+        {
+            if (numPredecessors[task] == 0)
+            {
+                orderedTasks.push_back(task);
+            }
+        }
+        initialTasks = orderedTasks;
+        for (size_t i = 0; i < orderedTasks.size(); i++)
+        {
+            for (const TaskId successor : successors_[orderedTasks[i]])
+            {
+                if (--numPredecessors[successor] == 0)
+                {
+                    orderedTasks.push_back(successor);
+                }
+            }
+        }
+        if (orderedTasks.size() < tasks_.size())
+        {
+            GMX_THROW(InvalidInputError("The task dependencies contain a cycle"));
+        }
+    }
+
+    std::vector<std::atomic<int>> numPredecessorsRemaining(numTasks());
+    for (TaskId task = 0; task < numTasks(); task++)
+    {
+        numPredecessorsRemaining[task] = numPredecessors_[task];
+    }
+
+    std::unique_ptr<ThreadTaskDeque[]> deques(new ThreadTaskDeque[numThreads]);
+    const int                          numInitialTasks = initialTasks.size();
+    for (int i = 0; i < numInitialTasks; i++)
+    {
+        deques[(i * numThreads) / numInitialTasks].tasks.push_back(initialTasks[i]);
+    }
+
+    std::atomic<int> numTasksRemaining(numTasks());
+
+#pragma omp parallel num_threads(numThreads)
+    {
+        try
+        {
+            const int thread = gmx_omp_get_thread_num();
+
+            while (numTasksRemaining > 0)
+            {
+                TaskId task;
+                bool   haveTask = takeFront(&deques[thread], &task);
+                for (int i = 1; i < numThreads && !haveTask; i++)
+                {
+                    haveTask = takeBack(&deques[(thread + i) % numThreads], &task);
+                }
+                if (!haveTask)
+                {
+                    /* All remaining tasks are running or waiting for running tasks */
+                    std::this_thread::yield();
+                    continue;
+                }
+
+                tasks_[task](thread);
+
+                /* Put the tasks that became ready at the front of our deque,
+                 * in the order in which the dependencies were added.
+                 */
+                const auto& successors = successors_[task];
+                for (auto successor = successors.rbegin(); successor != successors.rend(); ++successor)
+                {
+                    if (--numPredecessorsRemaining[*successor] == 0)
+                    {
+                        std::lock_guard<std::mutex> lock(deques[thread].mutex);
+                        deques[thread].tasks.push_front(*successor);
+                    }
+                }
+
+                numTasksRemaining--;
+            }
+        }
+        GMX_CATCH_ALL_AND_EXIT_WITH_FATAL_ERROR
+    }
+}
+
+} // namespace gmx
@@ -0,0 +1,120 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \libinternal \file
+ * \brief
+ * Declares gmx::TaskGraph, a graph of tasks executed by OpenMP threads
+ * with work stealing.
+ *
+ * \inlibraryapi
+ * \ingroup module_utility
+ */
+#ifndef GMX_UTILITY_TASKGRAPH_H
+#define GMX_UTILITY_TASKGRAPH_H
+
+#include <functional>
+#include <vector>
+
+namespace gmx
+{
+
+/*! \libinternal \brief
+ * A graph of tasks with dependencies, executed by OpenMP threads with work stealing
+ *
+ * This is intended for irregular intra-rank work, where a static
+ * distribution over the threads leaves threads waiting at the barrier
+ * at the end of the parallel region. The work is split into more tasks
+ * than threads. Each thread has its own deque of ready tasks. A thread
+ * first processes the tasks in its own deque, in the order they were
+ * added, and then steals tasks from the end of the deques of other
+ * threads. When a task finishes, the tasks that only depended on it
+ * are put at the front of the deque of the thread that ran it.
+ *
+ * The tasks are called with the index of the thread that executes
+ * them, so they can use thread-local output buffers. Tasks should not
+ * throw; exceptions are handled as for other OpenMP regions by
+ * terminating with a fatal error.
+ *
+ * A graph can be run multiple times.
+ *
+ * \inlibraryapi
+ * \ingroup module_utility
+ */
+class TaskGraph
+{
+public:
+    //! Index of a task in the graph
+    using TaskId = int;
+    //! The function executed by a task, the argument is the thread index
+    using TaskFunction = std::function<void(int)>;
+
+    /*! \brief Adds a task and returns its id
+     *
+     * Without dependencies, tasks are initially distributed over the
+     * threads in contiguous blocks, in the order in which they are added.
+     */
+    TaskId addTask(TaskFunction task);
+
+    /*! \brief Adds the dependency that task \p after can only start when \p before has finished
+     *
+     * \throws InvalidInputError when one of the ids is invalid or when they are identical.
+     */
+    void addDependency(TaskId before, TaskId after);
+
+    //! Returns the number of tasks
+    int numTasks() const { return tasks_.size(); }
+
+    //! Removes all tasks and dependencies
+    void clear();
+
+    /*! \brief Runs all tasks in an OpenMP parallel region with \p numThreads threads
+     *
+     * Must be called outside of an OpenMP parallel region.
+     *
+     * \throws InvalidInputError when the dependencies contain a cycle.
+     */
+    void run(int numThreads) const;
+
+private:
+    //! The tasks
+    std::vector<TaskFunction> tasks_;
+    //! For each task, the tasks that depend on it
+    std::vector<std::vector<TaskId>> successors_;
+    //! For each task, the number of tasks it depends on
+    std::vector<int> numPredecessors_;
+};
+
+} // namespace gmx
+
+#endif
@@ -33,7 +33,8 @@
  * the research papers on the package. Check out http://www.gromacs.org.
  */
 /*! \internal \file
- * \brief Tests for gmx::AlignedAllocator and gmx::PageAlignedAllocator.
+ * \brief Tests for gmx::AlignedAllocator, gmx::PageAlignedAllocator
+ * and gmx::NumaAwareAllocator.
  *
  * \author Erik Lindahl <erik.lindahl@gmail.com>
  * \author Mark Abraham <mark.j.abraham@gmail.com>
@@ -59,10 +60,13 @@ namespace test
 //! Declare allocator types to test.
 using AllocatorTypesToTest = ::testing::Types<AlignedAllocator<real>,
                                               PageAlignedAllocator<real>,
+                                              NumaAwareAllocator<real>,
                                               AlignedAllocator<int>,
                                               PageAlignedAllocator<int>,
+                                              NumaAwareAllocator<int>,
                                               AlignedAllocator<RVec>,
-                                              PageAlignedAllocator<RVec>>;
+                                              PageAlignedAllocator<RVec>,
+                                              NumaAwareAllocator<RVec>>;
 
 TYPED_TEST_CASE(AllocatorTest, AllocatorTypesToTest);
 
@@ -90,6 +94,21 @@ TEST(AllocatorUntypedTest, Comparison)
     // Should always be true for the same policy, indpendent of value_type
     EXPECT_EQ(AlignedAllocator<float>{}, AlignedAllocator<double>{});
     EXPECT_EQ(PageAlignedAllocator<float>{}, PageAlignedAllocator<double>{});
+    EXPECT_EQ(NumaAwareAllocator<float>{}, NumaAwareAllocator<double>{});
+}
+
+TEST(AllocatorUntypedTest, NumaAwareAllocatorDistributesPagesOfLargeAllocations)
+{
+    const std::size_t pageSize = PageAlignedAllocationPolicy::alignment();
+
+    NumaAwareAllocationPolicy::setNumThreadsForFirstTouch(2);
+    {
+        std::vector<char, NumaAwareAllocator<char>> v(4 * pageSize + 1, 'a');
+        EXPECT_EQ(0, reinterpret_cast<std::size_t>(v.data()) & (pageSize - 1));
+        EXPECT_EQ('a', v.front());
+        EXPECT_EQ('a', v.back());
+    }
+    NumaAwareAllocationPolicy::setNumThreadsForFirstTouch(1);
 }
 
 } // namespace test
@@ -47,6 +47,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include "gromacs/math/vectypes.h"
+
 namespace gmx
 {
 namespace test
@@ -241,6 +243,45 @@ TEST_F(InMemorySerializerTest, DeserializerExplicitEndianessSwap)
     checkSerializerValuesforEquality(endianessSwappedValues_, deserialisedValues);
 }
 
+TEST_F(InMemorySerializerTest, RvecArrayRoundtripWithEndianessSwap)
+{
+    std::vector<RVec> values = { { 1.5, -2.25, 3.125 }, { 4, 5e-3, -6e7 } };
+
+    for (bool writeDouble : { false, true })
+    {
+        // Write the values one by one, as float or double
+        InMemorySerializer serializer(EndianSwapBehavior::Swap);
+        for (RVec& v : values)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                if (writeDouble)
+                {
+                    double value = v[d];
+                    serializer.doDouble(&value);
+                }
+                else
+                {
+                    float value = v[d];
+                    serializer.doFloat(&value);
+                }
+            }
+        }
+        auto buffer = serializer.finishAndGetBuffer();
+
+        InMemoryDeserializer deserializer(buffer, writeDouble, EndianSwapBehavior::Swap);
+        std::vector<RVec>    result(values.size());
+        deserializer.doRvecArray(as_rvec_array(result.data()), result.size());
+        for (size_t i = 0; i < values.size(); i++)
+        {
+            for (int d = 0; d < DIM; d++)
+            {
+                EXPECT_EQ(values[i][d], result[i][d]);
+            }
+        }
+    }
+}
+
 TEST_F(InMemorySerializerTest, SizeIsCorrect)
 {
     InMemorySerializer serializer;
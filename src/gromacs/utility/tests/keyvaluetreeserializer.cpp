@@ -38,6 +38,7 @@
 
 #include <cstddef>
 
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
 #include "gromacs/utility/inmemoryserializer.h"
@@ -155,4 +156,41 @@ TEST_F(KeyValueTreeSerializerTest, ObjectWithObjects)
     runTest();
 }
 
+TEST(KeyValueTreeTypedArraySerializerTest, RoundTripsWithAndWithoutEndianSwap)
+{
+    const std::vector<int>     intValues    = { 1, -2, 0x7ABCDEF0 };
+    const std::vector<int64_t> int64Values  = { INT64_C(0x78ABCDEF12345678), -5 };
+    const std::vector<float>   floatValues  = { 1.5F, -2.25e7F, 3.125e-3F, 0.0F };
+    const std::vector<double>  doubleValues = { 1.0 / 3.0, -1e300 };
+
+    gmx::KeyValueTreeBuilder builder;
+    builder.rootObject().addTypedArray<int>("i", intValues);
+    builder.rootObject().addTypedArray<int64_t>("l", int64Values);
+    builder.rootObject().addTypedArray<float>("f", floatValues);
+    builder.rootObject().addTypedArray<double>("d", doubleValues);
+    builder.rootObject().addTypedArray<double>("empty", {});
+    const gmx::KeyValueTreeObject input = builder.build();
+
+    for (auto endianSwapBehavior :
+         { gmx::EndianSwapBehavior::DoNotSwap, gmx::EndianSwapBehavior::Swap })
+    {
+        gmx::InMemorySerializer serializer(endianSwapBehavior);
+        gmx::serializeKeyValueTree(input, &serializer);
+        std::vector<char> buffer = serializer.finishAndGetBuffer();
+
+        gmx::InMemoryDeserializer deserializer(buffer, false, endianSwapBehavior);
+        gmx::KeyValueTreeObject   output = gmx::deserializeKeyValueTree(&deserializer);
+        ASSERT_TRUE(output["i"].isTypedArray());
+        EXPECT_THAT(output["i"].asTypedArray<int>(),
+                    ::testing::Pointwise(::testing::Eq(), intValues));
+        EXPECT_THAT(output["l"].asTypedArray<int64_t>(),
+                    ::testing::Pointwise(::testing::Eq(), int64Values));
+        EXPECT_THAT(output["f"].asTypedArray<float>(),
+                    ::testing::Pointwise(::testing::Eq(), floatValues));
+        EXPECT_THAT(output["d"].asTypedArray<double>(),
+                    ::testing::Pointwise(::testing::Eq(), doubleValues));
+        EXPECT_TRUE(output["empty"].asTypedArray<double>().empty());
+    }
+}
+
 } // namespace
@@ -0,0 +1,167 @@
+/*
+ * This file is part of the GROMACS molecular simulation package.
+ *
+ * Copyright (c) 2021, by the GROMACS development team, led by
+ * Mark Abraham, David van der Spoel, Berk Hess, and Erik Lindahl,
+ * and including many others, as listed in the AUTHORS file in the
+ * top-level source directory and at http://www.gromacs.org.
+ *
+ * GROMACS is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public License
+ * as published by the Free Software Foundation; either version 2.1
+ * of the License, or (at your option) any later version.
+ *
+ * GROMACS is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with GROMACS; if not, see
+ * http://www.gnu.org/licenses, or write to the Free Software Foundation,
+ * Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA.
+ *
+ * If you want to redistribute modifications to GROMACS, please
+ * consider that scientific software is very special. Version
+ * control is crucial - bugs must be traceable. We will be happy to
+ * consider code for inclusion in the official distribution, but
+ * derived work must not be called official GROMACS. Details are found
+ * in the README & COPYING files - if they are missing, get the
+ * official version at http://www.gromacs.org.
+ *
+ * To help us fund GROMACS development, we humbly ask that you cite
+ * the research papers on the package. Check out http://www.gromacs.org.
+ */
+/*! \internal \file
+ * \brief
+ * Tests for the TaskGraph class.
+ *
+ * \ingroup module_utility
+ */
+#include "gmxpre.h"
+
+#include "gromacs/utility/taskgraph.h"
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "gromacs/utility/exceptions.h"
+
+#include "testutils/testasserts.h"
+
+namespace gmx
+{
+
+namespace
+{
+
+TEST(TaskGraphTest, RunsAllTasksOnce)
+{
+    const int                     numTasks = 100;
+    std::vector<std::atomic<int>> numCalls(numTasks);
+    TaskGraph                     taskGraph;
+    for (int i = 0; i < numTasks; i++)
+    {
+        numCalls[i] = 0;
+        taskGraph.addTask([&numCalls, i](int /*thread*/) { numCalls[i]++; });
+    }
+    EXPECT_EQ(numTasks, taskGraph.numTasks());
+
+    for (int numThreads : { 1, 2, 4 })
+    {
+        taskGraph.run(numThreads);
+    }
+    for (int i = 0; i < numTasks; i++)
+    {
+        EXPECT_EQ(3, numCalls[i]);
+    }
+}
+
+TEST(TaskGraphTest, PassesValidThreadIndices)
+{
+    const int        numThreads = 3;
+    std::atomic<int> numInvalidThreads(0);
+    TaskGraph        taskGraph;
+    for (int i = 0; i < 20; i++)
+    {
+        taskGraph.addTask([&numInvalidThreads](int thread) {
+            if (thread < 0 || thread >= numThreads)
+            {
+                numInvalidThreads++;
+            }
+        });
+    }
+    taskGraph.run(numThreads);
+    EXPECT_EQ(0, numInvalidThreads);
+}
+
+TEST(TaskGraphTest, RespectsDependencies)
+{
+    /* A chain of layers, where each task depends on all tasks in the previous layer */
+    const int        numLayers     = 5;
+    const int        tasksPerLayer = 7;
+    std::atomic<int> counter(0);
+    std::vector<int> order(numLayers * tasksPerLayer, -1);
+    TaskGraph        taskGraph;
+    for (int layer = 0; layer < numLayers; layer++)
+    {
+        for (int i = 0; i < tasksPerLayer; i++)
+        {
+            const int               index = layer * tasksPerLayer + i;
+            const TaskGraph::TaskId task =
+                    taskGraph.addTask([&counter, &order, index](int /*thread*/) { order[index] = counter++; });
+            for (int j = 0; layer > 0 && j < tasksPerLayer; j++)
+            {
+                taskGraph.addDependency((layer - 1) * tasksPerLayer + j, task);
+            }
+        }
+    }
+
+    taskGraph.run(4);
+
+    for (int layer = 1; layer < numLayers; layer++)
+    {
+        for (int i = 0; i < tasksPerLayer; i++)
+        {
+            for (int j = 0; j < tasksPerLayer; j++)
+            {
+                EXPECT_LT(order[(layer - 1) * tasksPerLayer + j], order[layer * tasksPerLayer + i]);
+            }
+        }
+    }
+}
+
+TEST(TaskGraphTest, ThrowsOnInvalidDependency)
+{
+    TaskGraph taskGraph;
+    taskGraph.addTask([](int /*thread*/) {});
+    EXPECT_THROW_GMX(taskGraph.addDependency(0, 1), InvalidInputError);
+    EXPECT_THROW_GMX(taskGraph.addDependency(0, 0), InvalidInputError);
+}
+
+TEST(TaskGraphTest, ThrowsOnCycle)
+{
+    TaskGraph taskGraph;
+    taskGraph.addTask([](int /*thread*/) {});
+    taskGraph.addTask([](int /*thread*/) {});
+    taskGraph.addTask([](int /*thread*/) {});
+    taskGraph.addDependency(0, 1);
+    taskGraph.addDependency(1, 2);
+    taskGraph.addDependency(2, 1);
+    EXPECT_THROW_GMX(taskGraph.run(2), InvalidInputError);
+}
+
+TEST(TaskGraphTest, ClearRemovesTasks)
+{
+    TaskGraph taskGraph;
+    taskGraph.addTask([](int /*thread*/) {});
+    taskGraph.clear();
+    EXPECT_EQ(0, taskGraph.numTasks());
+    taskGraph.run(2);
+}
+
+} // namespace
+
+} // namespace gmx
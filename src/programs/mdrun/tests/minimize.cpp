@@ -137,18 +137,7 @@ TEST_P(EnergyMinimizationTest, WithinTolerances)
     {
         CommandLine mdrunCaller;
         mdrunCaller.append("mdrun");
-        if (minimizer == "l-bfgs" && getNumberOfTestMpiRanks() > 1)
-        {
-            // Ideally we would use this death test, but it is not
-            // stable enough in Jenkins, so we just skip it.
-            // EXPECT_DEATH_IF_SUPPORTED(runner_.callMdrun(mdrunCaller),
-            //                          "L-BFGS minimization only supports a single rank");
-            return;
-        }
-        else
-        {
-            ASSERT_EQ(0, runner_.callMdrun(mdrunCaller));
-        }
+        ASSERT_EQ(0, runner_.callMdrun(mdrunCaller));
     }
 
     EnergyTermsToCompare energyTermsToCompare{ {
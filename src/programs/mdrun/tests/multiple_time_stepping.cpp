@@ -104,6 +104,21 @@ TEST_P(MtsComparisonTest, WithinTolerances)
             "constraints  = h-bonds\n",
             numSteps);
 
+    if (mtsScheme.find("pull") != std::string::npos)
+    {
+        sharedMdpOptions +=
+                "pull                 = yes\n"
+                "pull-ngroups         = 2\n"
+                "pull-group1-name     = MainChain\n"
+                "pull-group2-name     = SideChain\n"
+                "pull-ncoords         = 1\n"
+                "pull-coord1-type     = umbrella\n"
+                "pull-coord1-geometry = distance\n"
+                "pull-coord1-groups   = 1 2\n"
+                "pull-coord1-init     = 1\n"
+                "pull-coord1-k        = 10000\n";
+    }
+
     // set nstfout to > numSteps so we only write forces at step 0
     const int nstfout       = 2 * numSteps;
     auto      refMdpOptions = sharedMdpOptions
@@ -187,7 +202,8 @@ INSTANTIATE_TEST_CASE_P(
         MtsComparisonTest,
         ::testing::Combine(::testing::Values("ala"),
                            ::testing::Values("longrange-nonbonded",
-                                             "longrange-nonbonded nonbonded pair dihedral")));
+                                             "longrange-nonbonded nonbonded pair dihedral",
+                                             "longrange-nonbonded pull")));
 
 } // namespace
 } // namespace test
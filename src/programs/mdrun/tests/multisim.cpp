@@ -45,8 +45,21 @@
 
 #include "config.h"
 
+#include <string>
+
 #include <gtest/gtest.h>
 
+#include "gromacs/topology/ifunc.h"
+#include "gromacs/trajectory/energyframe.h"
+#include "gromacs/utility/stringutil.h"
+
+#include "testutils/cmdlinetest.h"
+#include "testutils/setenv.h"
+#include "testutils/testasserts.h"
+
+#include "energycomparison.h"
+#include "energyreader.h"
+#include "moduletest.h"
 #include "multisimtest.h"
 
 namespace gmx
@@ -114,5 +127,85 @@ TEST_F(MultiSimTerminationTest, WritesCheckpointAfterMaxhTerminationAndThenResta
     runMaxhTest();
 }
 
+//! Convenience typedef
+typedef MultiSimTest MultiSimRerunTest;
+
+/* This test ensures that splitting the frames of a trajectory over the
+ * simulations of a rerun reproduces the energies of a rerun in which
+ * every simulation processes all frames of the same trajectory. */
+TEST_F(MultiSimRerunTest, SplitFramesReproduceEnergiesOfUnsplitRerun)
+{
+    if (size_ <= 1)
+    {
+        /* Can't test splitting frames without multiple ranks. */
+        return;
+    }
+    SimulationRunner runner(&fileManager_);
+    runner.useTopGroAndNdxFromDatabase("spc2");
+
+    /* All simulations run the same dynamics, so they write identical
+       trajectories, with more frames than simulations. */
+    const int numFrames = 2 * size_ + 1;
+    runner.useStringAsMdpFile(formatString(
+            "nsteps = %d\n"
+            "nstxout = 1\n"
+            "nstcalcenergy = 1\n"
+            "nstenergy = 1\n"
+            "gen-vel = yes\n"
+            "gen-temp = 298\n"
+            "gen-seed = 1993\n",
+            numFrames - 1));
+    /* Call grompp on every rank - the standard callGrompp() only runs
+       grompp on rank 0. */
+    EXPECT_EQ(0, runner.callGromppOnThisRank());
+
+    const std::string trajectoryFileName    = fileManager_.getTemporaryFilePath("traj.trr");
+    runner.fullPrecisionTrajectoryFileName_ = trajectoryFileName;
+    ASSERT_EQ(0, runner.callMdrun(*mdrunCaller_));
+
+    CommandLine rerunCaller(*mdrunCaller_);
+    rerunCaller.addOption("-rerun", trajectoryFileName);
+
+    // Rerun all frames in every simulation
+    const std::string unsplitEdrFileName    = fileManager_.getTemporaryFilePath("unsplit.edr");
+    runner.fullPrecisionTrajectoryFileName_ = fileManager_.getTemporaryFilePath("unsplit.trr");
+    runner.edrFileName_                     = unsplitEdrFileName;
+    ASSERT_EQ(0, runner.callMdrun(rerunCaller));
+
+    // Rerun only the block of frames of each simulation
+    const std::string splitEdrFileName      = fileManager_.getTemporaryFilePath("split.edr");
+    runner.fullPrecisionTrajectoryFileName_ = fileManager_.getTemporaryFilePath("split.trr");
+    runner.edrFileName_                     = splitEdrFileName;
+    gmxSetenv("GMX_RERUN_SPLIT_FRAMES", "ON", true);
+    const int splitRerunReturnValue = runner.callMdrun(rerunCaller);
+    gmxUnsetenv("GMX_RERUN_SPLIT_FRAMES");
+    ASSERT_EQ(0, splitRerunReturnValue);
+
+    EnergyTermsToCompare energyTermsToCompare{
+        { { interaction_function[F_EPOT].longname,
+            relativeToleranceAsPrecisionDependentUlp(10.0, 24, 32) } }
+    };
+    EnergyComparison energyComparison(energyTermsToCompare, MaxNumFrames::compareAllFrames());
+    auto energyNames         = energyComparison.getEnergyNames();
+    auto unsplitEnergyReader = openEnergyFileToReadTerms(unsplitEdrFileName, energyNames);
+    auto splitEnergyReader   = openEnergyFileToReadTerms(splitEdrFileName, energyNames);
+
+    // The frames of each block differ in number by at most one
+    const int firstFrame = (numFrames * rank_) / size_;
+    const int endFrame   = (numFrames * (rank_ + 1)) / size_;
+    for (int frame = 0; frame < firstFrame; frame++)
+    {
+        ASSERT_TRUE(unsplitEnergyReader->readNextFrame());
+        unsplitEnergyReader->frame();
+    }
+    for (int frame = firstFrame; frame < endFrame; frame++)
+    {
+        ASSERT_TRUE(unsplitEnergyReader->readNextFrame());
+        ASSERT_TRUE(splitEnergyReader->readNextFrame()) << "Missing frame " << frame;
+        energyComparison(unsplitEnergyReader->frame(), splitEnergyReader->frame());
+    }
+    EXPECT_FALSE(splitEnergyReader->readNextFrame()) << "Frames outside the block were processed";
+}
+
 } // namespace test
 } // namespace gmx
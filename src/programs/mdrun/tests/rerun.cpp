@@ -49,6 +49,7 @@
 #include "gromacs/utility/stringutil.h"
 
 #include "testutils/mpitest.h"
+#include "testutils/setenv.h"
 #include "testutils/simulationdatabase.h"
 
 #include "moduletest.h"
@@ -267,6 +268,77 @@ INSTANTIATE_TEST_CASE_P(DISABLED_MdrunIsReproduced,
                                            ::testing::Range(0, 11)));
 #endif
 
+/*! \brief Test fixture for mdrun -rerun with reuse of the pair list
+ *
+ * This test ensures that a rerun which reuses the pair list over
+ * frames, as enabled by GMX_RERUN_REUSE_PAIRLIST, reproduces the
+ * energies of a rerun that searches for pairs at every frame. The
+ * trajectory is written every step, so the list is actually reused,
+ * and is parametrized by pressure coupling, so that the reuse also
+ * has to handle a box that changes between frames. */
+class MdrunRerunPairlistReuseTest :
+    public MdrunTestFixture,
+    public ::testing::WithParamInterface<std::string>
+{
+};
+
+TEST_P(MdrunRerunPairlistReuseTest, ReproducesEnergiesOfSearchingEveryFrame)
+{
+    const std::string simulationName = "spc216";
+    const std::string pcoupl         = GetParam();
+    SCOPED_TRACE(formatString("Comparing reruns with and without pair-list reuse of simulation "
+                              "'%s' with pressure coupling '%s'",
+                              simulationName.c_str(), pcoupl.c_str()));
+
+    auto mdpFieldValues = prepareMdpFieldValues(simulationName, "md", "v-rescale", pcoupl);
+    mdpFieldValues["nstxout"]       = "1";
+    mdpFieldValues["nstenergy"]     = "1";
+    mdpFieldValues["nstcalcenergy"] = "1";
+    mdpFieldValues["nstpcouple"]    = "1";
+    mdpFieldValues["tau-p"]         = "0.1";
+
+    runner_.useTopGroAndNdxFromDatabase(simulationName);
+    runner_.useStringAsMdpFile(prepareMdpFileContents(mdpFieldValues));
+    runGrompp(&runner_);
+
+    const std::string trajectoryFileName = fileManager_.getTemporaryFilePath("sim.trr");
+    runner_.fullPrecisionTrajectoryFileName_ = trajectoryFileName;
+    runMdrun(&runner_);
+
+    // Rerun with a pair search at every frame
+    const std::string searchEdrFileName      = fileManager_.getTemporaryFilePath("search.edr");
+    runner_.fullPrecisionTrajectoryFileName_ = fileManager_.getTemporaryFilePath("search.trr");
+    runner_.edrFileName_                     = searchEdrFileName;
+    runMdrun(&runner_, { SimulationOptionTuple("-rerun", trajectoryFileName) });
+
+    // Rerun reusing the pair list
+    const std::string reuseEdrFileName       = fileManager_.getTemporaryFilePath("reuse.edr");
+    runner_.fullPrecisionTrajectoryFileName_ = fileManager_.getTemporaryFilePath("reuse.trr");
+    runner_.edrFileName_                     = reuseEdrFileName;
+    gmxSetenv("GMX_RERUN_REUSE_PAIRLIST", "ON", true);
+    runMdrun(&runner_, { SimulationOptionTuple("-rerun", trajectoryFileName) });
+    gmxUnsetenv("GMX_RERUN_REUSE_PAIRLIST");
+
+    // The reuse moves atoms to other periodic images, which changes
+    // the rounding of pair distances, and a larger buffer changes the
+    // summation order
+    EnergyTermsToCompare energyTermsToCompare{
+        { { interaction_function[F_EPOT].longname,
+            relativeToleranceAsPrecisionDependentFloatingPoint(10.0, 1e-5, 1e-10) } }
+    };
+    compareEnergies(searchEdrFileName, reuseEdrFileName, energyTermsToCompare);
+}
+
+#if !GMX_GPU_OPENCL
+INSTANTIATE_TEST_CASE_P(PairlistReuseReproducesSearch,
+                        MdrunRerunPairlistReuseTest,
+                        ::testing::Values("no", "c-rescale"));
+#else
+INSTANTIATE_TEST_CASE_P(DISABLED_PairlistReuseReproducesSearch,
+                        MdrunRerunPairlistReuseTest,
+                        ::testing::Values("no", "c-rescale"));
+#endif
+
 } // namespace
 } // namespace test
 } // namespace gmx